@@ -0,0 +1,57 @@
+#pragma once
+
+#include <agentguard/agentguard.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace agentguard::bench {
+
+// Heap allocations observed by the replacement operator new in the
+// benchmark binary (see AGENTGUARD_BENCH_COUNT_ALLOCATIONS).
+inline std::atomic<std::size_t>& allocation_count() {
+    static std::atomic<std::size_t> count{0};
+    return count;
+}
+
+// Worst case for the round-based safety loop: exactly one agent becomes
+// runnable per round, in reverse row order. Every agent holds one unit of
+// each resource and needs one more, and row i needs (agents - 1 - i) extra
+// units of the blocking resource, so each release unblocks only the row
+// above it. A blocking resource in the last column makes every failed
+// can_finish read the whole row.
+inline SafetyMatrix make_staircase(std::size_t agents, std::size_t resources,
+                                   std::size_t blocking = 0) {
+    SafetyMatrix m;
+    for (std::size_t r = 0; r < resources; ++r) {
+        std::size_t col = m.add_resource(static_cast<ResourceTypeId>(r));
+        m.set_total(col, static_cast<ResourceQuantity>(agents + 1));
+        m.set_available(col, 1);
+    }
+    for (std::size_t a = 0; a < agents; ++a) {
+        std::size_t row = m.add_agent(static_cast<AgentId>(a + 1));
+        for (std::size_t r = 0; r < resources; ++r) {
+            std::size_t col = m.resource_slot(static_cast<ResourceTypeId>(r));
+            ResourceQuantity extra = (r == blocking) ? static_cast<ResourceQuantity>(agents - 1 - a) : 0;
+            m.set_allocation(row, col, 1);
+            m.set_max_need(row, col, 2 + extra);
+        }
+    }
+    return m;
+}
+
+} // namespace agentguard::bench
+
+// Defines replacement global operator new/delete that bump
+// allocation_count(). Expand in exactly one translation unit.
+#define AGENTGUARD_BENCH_COUNT_ALLOCATIONS                                     \
+    void* operator new(std::size_t size) {                                     \
+        ::agentguard::bench::allocation_count().fetch_add(                     \
+            1, std::memory_order_relaxed);                                     \
+        if (void* p = std::malloc(size == 0 ? 1 : size)) return p;             \
+        throw std::bad_alloc();                                                \
+    }                                                                          \
+    void operator delete(void* p) noexcept { std::free(p); }                   \
+    void operator delete(void* p, std::size_t) noexcept { std::free(p); }
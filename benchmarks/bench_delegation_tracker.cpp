@@ -0,0 +1,56 @@
+// DelegationTracker::report_delegation at the end of deep delegation chains,
+// where the cycle check has to walk the whole chain.
+
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+using namespace agentguard;
+
+namespace {
+
+// Chain 1 -> 2 -> ... -> depth
+std::unique_ptr<DelegationTracker> make_chain(AgentId depth) {
+    DelegationConfig cfg;
+    cfg.enabled = true;
+    cfg.cycle_action = DelegationCycleAction::RejectDelegation;
+    auto tracker = std::make_unique<DelegationTracker>(cfg);
+    for (AgentId a = 0; a <= depth; ++a) {
+        tracker->register_agent(a);
+    }
+    for (AgentId a = 1; a < depth; ++a) {
+        tracker->report_delegation(a, a + 1);
+    }
+    return tracker;
+}
+
+// A new root delegates to the head of the chain: the search from the head
+// walks all the way down without finding the root, then the edge is removed
+void BM_Delegation_NoCycle(benchmark::State& state) {
+    auto depth = static_cast<AgentId>(state.range(0));
+    auto tracker = make_chain(depth);
+
+    for (auto _ : state) {
+        auto result = tracker->report_delegation(0, 1);
+        benchmark::DoNotOptimize(result.accepted);
+        tracker->complete_delegation(0, 1);
+    }
+}
+BENCHMARK(BM_Delegation_NoCycle)->RangeMultiplier(4)->Range(16, 4096);
+
+// The tail delegates back to the head, closing a cycle the length of the
+// chain; the edge is rejected so the chain is unchanged between iterations
+void BM_Delegation_CycleRejected(benchmark::State& state) {
+    auto depth = static_cast<AgentId>(state.range(0));
+    auto tracker = make_chain(depth);
+
+    for (auto _ : state) {
+        auto result = tracker->report_delegation(depth, 1);
+        benchmark::DoNotOptimize(result.cycle_path.size());
+    }
+}
+BENCHMARK(BM_Delegation_CycleRejected)->RangeMultiplier(4)->Range(16, 4096);
+
+} // namespace
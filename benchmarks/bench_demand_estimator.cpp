@@ -0,0 +1,41 @@
+// DemandEstimator::estimate_all_max_needs over a populated history.
+
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace agentguard;
+
+namespace {
+
+// range(0): agents, range(1): resource types
+void BM_EstimateAllMaxNeeds(benchmark::State& state) {
+    auto agents = static_cast<AgentId>(state.range(0));
+    auto resources = static_cast<ResourceTypeId>(state.range(1));
+
+    AdaptiveConfig cfg;
+    cfg.enabled = true;
+    DemandEstimator estimator(cfg);
+    for (AgentId a = 1; a <= agents; ++a) {
+        estimator.set_agent_demand_mode(a, DemandMode::Adaptive);
+        for (ResourceTypeId rt = 0; rt < resources; ++rt) {
+            // Fill the rolling window with a spread of observations
+            for (std::size_t i = 0; i < cfg.history_window_size; ++i) {
+                auto qty = static_cast<ResourceQuantity>(1 + (a + rt + i) % 7);
+                estimator.record_request(a, rt, qty);
+                estimator.record_allocation_level(a, rt, qty * 2);
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        auto estimates = estimator.estimate_all_max_needs(cfg.default_confidence_level);
+        benchmark::DoNotOptimize(estimates.size());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(agents * resources));
+}
+BENCHMARK(BM_EstimateAllMaxNeeds)
+    ->Args({16, 4})->Args({128, 4})->Args({128, 16})->Args({1024, 8});
+
+} // namespace
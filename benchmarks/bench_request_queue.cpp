@@ -0,0 +1,95 @@
+// RequestQueue enqueue/dequeue/cancel, single-threaded and under contention.
+
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace agentguard;
+
+namespace {
+
+ResourceRequest make_request(std::size_t i) {
+    ResourceRequest req;
+    req.agent_id = static_cast<AgentId>(i % 64 + 1);
+    req.resource_type = static_cast<ResourceTypeId>(i % 8);
+    req.quantity = 1;
+    req.priority = static_cast<Priority>(i % 4) * PRIORITY_NORMAL;
+    req.submitted_at = Clock::now();
+    return req;
+}
+
+// Fill to depth n, then drain, all on one thread
+void BM_Queue_EnqueueDequeue(benchmark::State& state) {
+    auto n = static_cast<std::size_t>(state.range(0));
+    RequestQueue queue(n);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) {
+            queue.enqueue(make_request(i));
+        }
+        while (auto req = queue.dequeue()) {
+            benchmark::DoNotOptimize(req->id);
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_Queue_EnqueueDequeue)->RangeMultiplier(8)->Range(8, 4096);
+
+// Cancel every request of a queue at depth n, oldest first
+void BM_Queue_Cancel(benchmark::State& state) {
+    auto n = static_cast<std::size_t>(state.range(0));
+    RequestQueue queue(n);
+    std::vector<RequestId> ids(n);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (std::size_t i = 0; i < n; ++i) {
+            ids[i] = queue.enqueue(make_request(i));
+        }
+        state.ResumeTiming();
+        for (auto id : ids) {
+            benchmark::DoNotOptimize(queue.cancel(id));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_Queue_Cancel)->RangeMultiplier(8)->Range(8, 4096);
+
+// Every thread enqueues then dequeues or cancels against one shared queue
+// that already holds a standing backlog
+std::unique_ptr<RequestQueue> shared_queue;
+
+void setup_shared_queue(const benchmark::State& state) {
+    shared_queue = std::make_unique<RequestQueue>(1 << 20);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i) {
+        shared_queue->enqueue(make_request(i));
+    }
+}
+
+void teardown_shared_queue(const benchmark::State&) {
+    shared_queue.reset();
+}
+
+void BM_Queue_Contended(benchmark::State& state) {
+    std::size_t i = static_cast<std::size_t>(state.thread_index());
+    for (auto _ : state) {
+        RequestId id = shared_queue->enqueue(make_request(i++));
+        if (i % 2 == 0) {
+            benchmark::DoNotOptimize(shared_queue->cancel(id));
+        } else {
+            benchmark::DoNotOptimize(shared_queue->dequeue());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Queue_Contended)
+    ->Arg(1024)
+    ->Setup(setup_shared_queue)
+    ->Teardown(teardown_shared_queue)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+} // namespace
@@ -0,0 +1,64 @@
+// request_resources grant/release round trips through ResourceManager.
+// Each thread drives its own agent against a shared pool large enough that
+// every request is granted immediately, so the numbers reflect the
+// admission path (locking, safety check, bookkeeping) rather than waiting.
+
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+using namespace agentguard;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kMaxThreads = 64;
+
+std::unique_ptr<ResourceManager> manager;
+AgentId agent_ids[kMaxThreads];
+
+// range(0): resource types in the pool
+void setup_manager(const benchmark::State& state) {
+    auto resources = static_cast<ResourceTypeId>(state.range(0));
+    manager = std::make_unique<ResourceManager>(Config{});
+    for (ResourceTypeId rt = 0; rt < resources; ++rt) {
+        manager->register_resource(
+            Resource(rt, "pool", ResourceCategory::Custom, kMaxThreads * 4));
+    }
+    for (int t = 0; t < kMaxThreads; ++t) {
+        Agent agent(static_cast<AgentId>(t + 1), "bench");
+        for (ResourceTypeId rt = 0; rt < resources; ++rt) {
+            agent.declare_max_need(rt, 4);
+        }
+        agent_ids[t] = manager->register_agent(std::move(agent));
+    }
+    manager->start();
+}
+
+void teardown_manager(const benchmark::State&) {
+    manager->stop();
+    manager.reset();
+}
+
+void BM_Manager_GrantRelease(benchmark::State& state) {
+    AgentId agent = agent_ids[state.thread_index()];
+    auto resources = static_cast<ResourceTypeId>(state.range(0));
+    ResourceTypeId rt = static_cast<ResourceTypeId>(state.thread_index()) % resources;
+
+    for (auto _ : state) {
+        auto status = manager->request_resources(agent, rt, 2, 1s);
+        benchmark::DoNotOptimize(status);
+        manager->release_resources(agent, rt, 2);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Manager_GrantRelease)
+    ->Arg(1)->Arg(8)
+    ->Setup(setup_manager)
+    ->Teardown(teardown_manager)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+} // namespace
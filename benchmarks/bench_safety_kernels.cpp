@@ -0,0 +1,79 @@
+// Row kernels of the dense safety loop, scalar vs the runtime-selected SIMD
+// implementation, at 8/64/256 resource types (max_resource_types is 256).
+
+#include "bench_common.hpp"
+#include "safety_kernels.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace agentguard;
+using agentguard::bench::make_staircase;
+using agentguard::detail::SafetyKernels;
+
+namespace {
+
+const SafetyKernels& kernels_for(bool simd) {
+    return simd ? detail::best_safety_kernels() : detail::scalar_safety_kernels();
+}
+
+void kernel_args(benchmark::internal::Benchmark* b) {
+    for (int simd : {0, 1}) {
+        for (int cols : {8, 64, 256}) {
+            b->Args({simd, cols});
+        }
+    }
+    b->ArgNames({"simd", "cols"});
+}
+
+// Worst case for can_finish: every lane passes, so the whole row is read
+void BM_CanFinish(benchmark::State& state) {
+    const auto& k = kernels_for(state.range(0) != 0);
+    auto cols = static_cast<std::size_t>(state.range(1));
+    std::vector<ResourceQuantity> need(cols, 3);
+    std::vector<ResourceQuantity> work(cols, 5);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(k.can_finish(need.data(), work.data(), cols));
+    }
+    state.SetLabel(k.name);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(2 * cols * sizeof(ResourceQuantity)));
+}
+BENCHMARK(BM_CanFinish)->Apply(kernel_args);
+
+void BM_ReleaseRow(benchmark::State& state) {
+    const auto& k = kernels_for(state.range(0) != 0);
+    auto cols = static_cast<std::size_t>(state.range(1));
+    std::vector<ResourceQuantity> alloc(cols, 1);
+    std::vector<ResourceQuantity> work(cols, 0);
+
+    for (auto _ : state) {
+        k.release_row(work.data(), alloc.data(), cols);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(k.name);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(2 * cols * sizeof(ResourceQuantity)));
+}
+BENCHMARK(BM_ReleaseRow)->Apply(kernel_args);
+
+// End to end: the classic loop on a 256-agent staircase blocked on the last
+// resource type, so every row test scans the full row
+void BM_CheckSafety_Kernels(benchmark::State& state) {
+    bool simd = state.range(0) != 0;
+    auto cols = static_cast<std::size_t>(state.range(1));
+    const auto matrix = make_staircase(256, cols, cols - 1);
+    SafetyChecker checker(SafetyAlgorithm::Classic, simd);
+    SafetyCheckResult result;
+
+    for (auto _ : state) {
+        checker.check_safety(matrix, result);
+        benchmark::DoNotOptimize(result.is_safe);
+    }
+    state.SetLabel(checker.kernel_name());
+}
+BENCHMARK(BM_CheckSafety_Kernels)->Apply(kernel_args);
+
+} // namespace
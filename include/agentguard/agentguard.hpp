@@ -11,10 +11,15 @@
 #include "agentguard/config.hpp"
 #include "agentguard/resource.hpp"
 #include "agentguard/agent.hpp"
+#include "agentguard/safety_matrix.hpp"
 #include "agentguard/safety_checker.hpp"
+#include "agentguard/executor.hpp"
+#include "agentguard/timer_wheel.hpp"
 #include "agentguard/request_queue.hpp"
 #include "agentguard/resource_manager.hpp"
 #include "agentguard/monitor.hpp"
+#include "agentguard/async_monitor.hpp"
+#include "agentguard/latency_histogram.hpp"
 #include "agentguard/policy.hpp"
 
 // Novel safety subsystems
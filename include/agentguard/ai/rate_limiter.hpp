@@ -17,6 +17,7 @@ public:
                 ResourceQuantity requests_per_window,
                 WindowType window);
 
+    // Sliding window: each consumed request returns one window later
     Resource as_resource() const;
 
     WindowType window_type() const noexcept;
@@ -12,6 +12,7 @@ public:
                 ResourceQuantity total_tokens_per_window,
                 Duration window_duration);
 
+    // Token bucket: consumed tokens return at tokens_per_second_rate()
     Resource as_resource() const;
 
     ResourceQuantity total_tokens_per_window() const noexcept;
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "agentguard/types.hpp"
+#include "agentguard/config.hpp"
+#include "agentguard/monitor.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace agentguard {
+
+// Decorator that takes event delivery off the caller's thread.
+//
+// on_event() copies the event into a bounded lock-free ring (multi-producer,
+// single-consumer) and returns; a dedicated dispatcher thread drains the ring
+// into the wrapped monitor in order. A slow monitor therefore never stalls
+// the grant path. When the ring is full the configured EventOverflowPolicy
+// applies and discarded events are counted in dropped_events(). Under Block
+// the emitting thread sleeps until the dispatcher frees a slot, so a monitor
+// slower than the event rate throttles its callers after all (never while
+// they hold the manager's state lock, which emits only after releasing it).
+//
+// on_snapshot() is forwarded synchronously. The wrapped monitor may see
+// snapshots and events from different threads. Subscriptions are the
+// wrapped monitor's, so unwanted events never reach the ring.
+class AsyncMonitor : public Monitor {
+public:
+    explicit AsyncMonitor(std::shared_ptr<Monitor> inner,
+                          AsyncMonitorConfig config = AsyncMonitorConfig{});
+    ~AsyncMonitor() override;
+
+    AsyncMonitor(const AsyncMonitor&) = delete;
+    AsyncMonitor& operator=(const AsyncMonitor&) = delete;
+
+    void on_event(const MonitorEvent& event) override;
+    void on_snapshot(const SystemSnapshot& snapshot) override;
+    EventMask subscribed_events() const override;
+    bool consumes_durations() const override;
+
+    // Blocks until every event accepted so far has been delivered
+    void flush();
+
+    std::uint64_t dropped_events() const noexcept;
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    const std::shared_ptr<Monitor>& inner() const noexcept { return inner_; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        MonitorEvent event;
+    };
+
+    std::shared_ptr<Monitor> inner_;
+    AsyncMonitorConfig config_;
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_{0};
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0};  // dispatcher only
+
+    std::atomic<std::uint64_t> accepted_{0};
+    std::atomic<std::uint64_t> delivered_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> sample_counter_{0};
+
+    // The dispatcher parks here when the ring is empty
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<bool> dispatcher_idle_{false};
+    std::atomic<bool> running_{true};
+    std::thread dispatcher_;
+
+    // flush() callers park here until the dispatcher has caught up
+    std::mutex drain_mutex_;
+    std::condition_variable drained_cv_;
+    std::atomic<std::size_t> flush_waiters_{0};
+
+    // Block-policy producers park here while the ring is full
+    std::mutex space_mutex_;
+    std::condition_variable space_cv_;
+    std::atomic<std::size_t> blocked_producers_{0};
+
+    bool try_push(const MonitorEvent& event);
+    bool push_when_space(const MonitorEvent& event);
+    bool try_pop(MonitorEvent& out);
+    std::size_t size() const noexcept;
+    void wake_dispatcher();
+    void dispatch_loop();
+};
+
+} // namespace agentguard
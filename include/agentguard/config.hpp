@@ -37,6 +37,51 @@ struct AdaptiveConfig {
     DemandMode default_demand_mode = DemandMode::Static;
 };
 
+// What AsyncMonitor does when its event ring is full
+enum class EventOverflowPolicy {
+    Drop,    // Discard the new event
+    Block,   // Sleep until the dispatcher frees a slot (stalls the emitter)
+    Sample   // Past half full, admit only one in sample_every events; drop when full
+};
+
+// Off-lock monitor event delivery (see AsyncMonitor)
+struct AsyncMonitorConfig {
+    bool enabled = false;
+    std::size_t capacity = 4096;  // rounded up to a power of two
+    EventOverflowPolicy overflow = EventOverflowPolicy::Drop;
+    std::size_t sample_every = 8;
+};
+
+// Group-commit admission for synchronous requests
+struct AdmissionConfig {
+    // Concurrent request_resources calls queue their first attempt and one
+    // thread (the combiner) evaluates the whole batch under a single lock hold
+    bool group_commit = false;
+    // How long a new combiner waits for more arrivals before evaluating
+    // (zero: take whatever queued up while the previous batch ran)
+    Duration window = Duration::zero();
+    std::size_t max_batch = 64;
+};
+
+// Where request completion callbacks run (see Executor)
+enum class CallbackExecution {
+    ThreadPool,  // A work-stealing ThreadPoolExecutor owned by the manager
+    Inline       // The completing thread, once internal locks are released
+};
+
+// Completion callback dispatch
+struct ExecutorConfig {
+    CallbackExecution mode = CallbackExecution::ThreadPool;
+    std::size_t threads = 2;  // pool size; 0 = one per hardware thread
+};
+
+// Timer wheel that returns consumed units of resources with a replenish
+// interval (see ResourceManager::consume_resources)
+struct ReplenishConfig {
+    Duration tick = std::chrono::milliseconds(10);  // refill granularity
+    std::size_t wheel_slots = 512;
+};
+
 struct Config {
     // Maximum number of agents that can be registered simultaneously
     std::size_t max_agents = 1024;
@@ -50,21 +95,45 @@ struct Config {
     // Default timeout for blocking requests (0 = no timeout)
     Duration default_request_timeout = std::chrono::seconds(30);
 
-    // How often the background processor checks the queue
+    // Unused: blocked requests and the background processor are both woken
+    // by the changes that concern them and never poll. Kept so existing
+    // configurations still compile.
     Duration processor_poll_interval = std::chrono::milliseconds(10);
 
-    // How often to emit system snapshots to the monitor
+    // How often to emit system snapshots to the monitor while the manager
+    // is running (zero disables)
     Duration snapshot_interval = std::chrono::seconds(5);
 
     // Enable automatic timeout expiration in the background
     bool enable_timeout_expiration = true;
 
-    // Warn if a request has been pending longer than this
+    // Requests pending longer than this are reported with a RequestStarved
+    // event (zero disables). Queued requests are checked by the background
+    // processor, blocked synchronous callers by themselves as they wake.
     Duration starvation_threshold = std::chrono::seconds(60);
 
+    // Added to a starved queued request's priority so priority-aware
+    // policies serve it sooner (0 = report only)
+    Priority starvation_priority_boost = 0;
+
     // If false, all locking is disabled (for single-threaded use)
     bool thread_safe = true;
 
+    // Safe-sequence search used by every safety check
+    SafetyAlgorithm safety_algorithm = SafetyAlgorithm::Classic;
+
+    // Use vectorized row kernels in the safety check when the CPU supports
+    // them (AVX2/AVX-512); results are identical to the scalar path
+    bool use_simd_kernels = true;
+
+    // Check each grant by first replaying the last safe sequence found (one
+    // linear pass) and only run the full search if the replay fails
+    bool reuse_safe_sequence = true;
+
+    // Track, per agent and resource, bounds on the largest grant that keeps
+    // the state safe; requests on either side of them skip the safety check
+    bool cache_grant_headroom = true;
+
     // Progress monitoring
     ProgressConfig progress;
 
@@ -73,6 +142,18 @@ struct Config {
 
     // Adaptive demand estimation
     AdaptiveConfig adaptive;
+
+    // Group-commit admission
+    AdmissionConfig admission;
+
+    // Wrap monitors passed to set_monitor() in an AsyncMonitor
+    AsyncMonitorConfig async_monitor;
+
+    // Completion callback dispatch (replaceable with set_executor())
+    ExecutorConfig executor;
+
+    // Replenishment of consumed rate-limit and token-budget units
+    ReplenishConfig replenish;
 };
 
 } // namespace agentguard
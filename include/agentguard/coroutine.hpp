@@ -0,0 +1,130 @@
+#pragma once
+
+// C++20 coroutine front end for ResourceManager. Not part of the umbrella
+// header since the library itself builds as C++17; include it directly from
+// a C++20 translation unit (see AGENTGUARD_ENABLE_COROUTINES).
+
+#if !defined(__cpp_impl_coroutine) || __cpp_impl_coroutine < 201902L
+#error "agentguard/coroutine.hpp requires C++20 coroutine support"
+#endif
+
+#include "agentguard/types.hpp"
+#include "agentguard/resource_manager.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace agentguard {
+
+// Awaitable for one request, for a single resource or for several granted
+// all-or-nothing. It behaves like request_resources_async(): the request is
+// validated and tried at once without suspending, so an uncontended acquire
+// completes in place and an invalid one rethrows from co_await.
+//
+// Otherwise suspending parks the request in the manager's queue, with the
+// configured default timeout if none is given; no thread blocks while it
+// waits. When the processor grants it, or it expires or is cancelled, the
+// completion runs on the manager's callback executor (outside its locks) and
+// hands the coroutine to `executor`, which must be invocable as
+// executor(std::coroutine_handle<>) and resumes it wherever the caller wants.
+template <typename Resume>
+class AcquireAwaitable {
+public:
+    AcquireAwaitable(ResourceManager& manager, AgentId agent_id,
+                     std::unordered_map<ResourceTypeId, ResourceQuantity> requests,
+                     std::optional<Duration> timeout, Resume executor)
+        : manager_(manager)
+        , agent_id_(agent_id)
+        , requests_(std::move(requests))
+        , timeout_(timeout)
+        , executor_(std::move(executor))
+    {}
+
+    bool await_ready() {
+        try {
+            bool granted = requests_.size() == 1
+                ? manager_.admit_now(agent_id_, requests_.begin()->first,
+                                     requests_.begin()->second)
+                : manager_.admit_now(agent_id_, requests_);
+            if (granted) status_ = RequestStatus::Granted;
+            return granted;
+        } catch (...) {
+            error_ = std::current_exception();
+            return true;
+        }
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The coroutine, and *this with it, may be gone once the completion
+        // hands it on, and may resume before enqueueing returns. So the
+        // completion carries its own handle and executor, and every argument
+        // is copied out before the request is made.
+        auto on_done = [status = &status_, handle, executor = executor_](
+                           RequestId, RequestStatus result) mutable {
+            *status = result;
+            executor(handle);
+        };
+        ResourceManager& manager = manager_;
+        AgentId agent_id = agent_id_;
+        std::optional<Duration> timeout = timeout_;
+        if (requests_.size() == 1) {
+            auto [rt, qty] = *requests_.begin();
+            manager.park(agent_id, rt, qty, std::move(on_done), timeout);
+        } else {
+            auto requests = requests_;
+            manager.park(agent_id, requests, std::move(on_done), timeout);
+        }
+    }
+
+    RequestStatus await_resume() const {
+        if (error_) std::rethrow_exception(error_);
+        return status_;
+    }
+
+private:
+    ResourceManager& manager_;
+    AgentId agent_id_;
+    std::unordered_map<ResourceTypeId, ResourceQuantity> requests_;
+    std::optional<Duration> timeout_;
+    Resume executor_;
+    RequestStatus status_{RequestStatus::Pending};
+    std::exception_ptr error_;  // validation failed; nothing was enqueued
+};
+
+// Resumes the coroutine on the manager's callback executor itself
+struct ResumeInline {
+    void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+};
+
+// co_await acquire(mgr, agent, rt, qty, timeout, executor) yields the final
+// RequestStatus. Requests that must wait are resolved by the background
+// processor, so they stay parked until the manager is started.
+template <typename Resume = ResumeInline>
+AcquireAwaitable<std::decay_t<Resume>> acquire(
+    ResourceManager& manager, AgentId agent_id, ResourceTypeId resource_type,
+    ResourceQuantity quantity, std::optional<Duration> timeout = std::nullopt,
+    Resume&& executor = Resume{})
+{
+    return AcquireAwaitable<std::decay_t<Resume>>(
+        manager, agent_id, {{resource_type, quantity}}, timeout,
+        std::forward<Resume>(executor));
+}
+
+// co_await acquire_all(mgr, agent, {{rt1, q1}, {rt2, q2}}, timeout, executor)
+// grants every resource together or none
+template <typename Resume = ResumeInline>
+AcquireAwaitable<std::decay_t<Resume>> acquire_all(
+    ResourceManager& manager, AgentId agent_id,
+    std::unordered_map<ResourceTypeId, ResourceQuantity> requests,
+    std::optional<Duration> timeout = std::nullopt, Resume&& executor = Resume{})
+{
+    return AcquireAwaitable<std::decay_t<Resume>>(
+        manager, agent_id, std::move(requests), timeout,
+        std::forward<Resume>(executor));
+}
+
+} // namespace agentguard
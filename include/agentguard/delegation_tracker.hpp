@@ -4,6 +4,7 @@
 #include "agentguard/config.hpp"
 #include "agentguard/monitor.hpp"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -68,6 +69,7 @@ private:
 
     std::unordered_set<AgentId> known_agents_;
     std::shared_ptr<Monitor> monitor_;
+    std::atomic<EventMask> event_mask_{0};  // monitor_'s subscriptions
 
     // Cycle detection: after adding edge (from, to), check if there's a path from 'to' back to 'from'
     std::vector<AgentId> detect_cycle_from(AgentId from, AgentId to) const;
@@ -75,6 +77,9 @@ private:
     // Full graph cycle detection (DFS with coloring)
     std::optional<std::vector<AgentId>> detect_any_cycle() const;
 
+    bool wants_event(EventType type) const noexcept {
+        return (event_mask_.load(std::memory_order_relaxed) & event_bit(type)) != 0;
+    }
     void emit_event(EventType type, const std::string& message,
                     std::optional<AgentId> from_agent = std::nullopt,
                     std::optional<AgentId> to_agent = std::nullopt,
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "agentguard/types.hpp"
+#include "agentguard/latency_histogram.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace agentguard {
+
+// Runs request completion callbacks. The manager and its queue only hand
+// tasks over after releasing every internal lock, so a task may call back
+// into the manager.
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void execute(std::function<void()> task) = 0;
+};
+
+// Runs each task immediately on the submitting thread
+class InlineExecutor : public Executor {
+public:
+    void execute(std::function<void()> task) override { task(); }
+};
+
+// Point-in-time view of a ThreadPoolExecutor
+struct ExecutorStats {
+    std::uint64_t submitted{0};
+    std::uint64_t completed{0};
+    std::uint64_t stolen{0};          // tasks run by a worker other than the one queued on
+    std::size_t queue_depth{0};       // submitted but not yet started
+    LatencySummary queue_wait_us;     // submission to start
+    LatencySummary run_time_us;       // task execution
+};
+
+// Fixed-size work-stealing pool. Each worker owns a deque: tasks submitted
+// from outside are spread round-robin, tasks submitted by a worker stay on
+// its own deque, and an idle worker steals from the back of a busy one's.
+// Workers start on the first execute(), so an unused pool costs no threads.
+// The destructor runs every queued task before joining. Exceptions thrown
+// by tasks are swallowed.
+class ThreadPoolExecutor : public Executor {
+public:
+    // 0 threads: one per hardware thread
+    explicit ThreadPoolExecutor(std::size_t threads = 0);
+    ~ThreadPoolExecutor() override;
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    void execute(std::function<void()> task) override;
+
+    std::size_t thread_count() const noexcept { return workers_.size(); }
+    ExecutorStats stats() const;
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        Timestamp enqueued;
+    };
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::once_flag started_;
+    std::atomic<std::size_t> next_worker_{0};
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<bool> stopping_{false};
+
+    // Idle workers park here
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> completed_{0};
+    std::atomic<std::uint64_t> stolen_{0};
+    LatencyHistogram queue_wait_ns_;
+    LatencyHistogram run_time_ns_;
+
+    void start();
+    void worker_loop(std::size_t index);
+    bool take(std::size_t index, Job& out);
+    void run(Job& job);
+};
+
+} // namespace agentguard
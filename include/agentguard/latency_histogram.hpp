@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace agentguard {
+
+// Percentile summary of a LatencyHistogram, in the histogram's unit times
+// the scale passed to summary()
+struct LatencySummary {
+    std::uint64_t count{0};
+    double mean{0.0};
+    double p50{0.0};
+    double p90{0.0};
+    double p99{0.0};
+    double p999{0.0};
+    double max{0.0};
+};
+
+// Log-bucketed histogram of non-negative integer values, in the style of
+// HdrHistogram: each power of two is split into SUB_BUCKETS linear buckets,
+// so any recorded value is reported within 1/SUB_BUCKETS of its true value.
+// Values below SUB_BUCKETS are exact; values past MAX_VALUE land in the top
+// bucket. record() is a handful of relaxed atomic adds and never blocks, so
+// any number of threads may record while others read percentiles.
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr std::uint64_t SUB_BUCKETS = std::uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_EXPONENT = 44;  // ~4.9 hours in nanoseconds
+    static constexpr std::uint64_t MAX_VALUE = (std::uint64_t{1} << (MAX_EXPONENT + 1)) - 1;
+    static constexpr std::size_t BUCKET_COUNT =
+        (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(std::uint64_t value) noexcept;
+
+    std::uint64_t count() const noexcept;
+    // Value at percentile p in [0, 100]; 0 when empty
+    std::uint64_t percentile(double p) const noexcept;
+    LatencySummary summary(double scale = 1.0) const noexcept;
+
+    // Not atomic with respect to concurrent record() calls
+    void reset() noexcept;
+
+    static std::size_t bucket_index(std::uint64_t value) noexcept;
+    // Midpoint of the values that map to a bucket
+    static std::uint64_t bucket_value(std::size_t index) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+} // namespace agentguard
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "agentguard/types.hpp"
+#include "agentguard/latency_histogram.hpp"
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -39,9 +45,33 @@ enum class EventType {
     // Adaptive demand events
     DemandEstimateUpdated,
     ProbabilisticSafetyCheck,
-    AdaptiveDemandModeChanged
+    AdaptiveDemandModeChanged,
+    // Contention: duration_us is how long the state lock was held
+    LockHeld,
+    // A request has waited past Config::starvation_threshold; duration_us
+    // is its age
+    RequestStarved,
+    // Rate-limit style resources: units used up by an agent, and consumed
+    // units returned by the replenishment timer
+    ResourcesConsumed,
+    ResourcesReplenished
 };
 
+// Set of event types, one bit per EventType enumerator
+using EventMask = std::uint64_t;
+
+constexpr EventMask ALL_EVENTS = ~EventMask{0};
+
+constexpr EventMask event_bit(EventType type) noexcept {
+    return EventMask{1} << static_cast<unsigned>(type);
+}
+
+constexpr EventMask event_mask(std::initializer_list<EventType> types) noexcept {
+    EventMask mask = 0;
+    for (EventType t : types) mask |= event_bit(t);
+    return mask;
+}
+
 struct MonitorEvent {
     EventType type;
     Timestamp timestamp;
@@ -58,8 +88,12 @@ struct MonitorEvent {
     // Delegation cycle detection: the cycle path
     std::optional<std::vector<AgentId>> cycle_path;
 
-    // Operation duration in microseconds (e.g., safety check duration)
+    // Operation duration in microseconds (e.g., safety check duration;
+    // for RequestGranted, the time from submission to grant)
     std::optional<double> duration_us;
+
+    // Priority of the requesting agent, when known
+    std::optional<Priority> priority;
 };
 
 // Abstract monitor interface
@@ -68,6 +102,14 @@ public:
     virtual ~Monitor() = default;
     virtual void on_event(const MonitorEvent& event) = 0;
     virtual void on_snapshot(const SystemSnapshot& snapshot) = 0;
+
+    // Event types this monitor wants. Emitters skip the others before
+    // building the event or its message. Read when the monitor is
+    // installed, so the answer should not change afterwards.
+    virtual EventMask subscribed_events() const { return ALL_EVENTS; }
+
+    // Whether duration_us is read; if not, emitters skip the timing
+    virtual bool consumes_durations() const { return true; }
 };
 
 // Console logger
@@ -79,12 +121,21 @@ public:
 
     void on_event(const MonitorEvent& event) override;
     void on_snapshot(const SystemSnapshot& snapshot) override;
+    EventMask subscribed_events() const override;
+    bool consumes_durations() const override { return false; }
 
 private:
     Verbosity verbosity_;
     mutable std::mutex output_mutex_;
 };
 
+// Latencies MetricsMonitor keeps histograms for
+enum class LatencyMetric {
+    Wait,         // submission to grant (RequestGranted duration)
+    SafetyCheck,  // SafetyCheckPerformed / ProbabilisticSafetyCheck duration
+    LockHold      // LockHeld duration
+};
+
 // Metrics collector
 class MetricsMonitor : public Monitor {
 public:
@@ -97,16 +148,27 @@ public:
         double safety_check_avg_duration_us{0.0};
         std::uint64_t unsafe_state_detections{0};
         double resource_utilization_percent{0.0};
+
+        // Tail latencies across all resources and priorities, in microseconds
+        LatencySummary wait_time_us;
+        LatencySummary safety_check_us;
+        LatencySummary lock_hold_us;
     };
 
     MetricsMonitor();
 
     void on_event(const MonitorEvent& event) override;
     void on_snapshot(const SystemSnapshot& snapshot) override;
+    EventMask subscribed_events() const override;
 
     Metrics get_metrics() const;
     void reset_metrics();
 
+    // Breakdowns in microseconds; empty summaries for unseen keys
+    LatencySummary latency(LatencyMetric metric) const;
+    LatencySummary latency_for_resource(LatencyMetric metric, ResourceTypeId rt) const;
+    LatencySummary latency_for_priority(LatencyMetric metric, PriorityClass pc) const;
+
     using AlertCallback = std::function<void(const std::string&)>;
     void set_utilization_alert_threshold(double threshold, AlertCallback cb);
     void set_queue_size_alert_threshold(std::size_t threshold, AlertCallback cb);
@@ -128,18 +190,40 @@ private:
     // Safety check duration tracking
     std::uint64_t safety_check_count_{0};
     double safety_check_duration_sum_us_{0.0};
+
+    // Histograms record nanoseconds without taking metrics_mutex_;
+    // latency_mutex_ only guards the per-resource maps
+    struct LatencySet {
+        LatencyHistogram overall;
+        std::array<LatencyHistogram, 4> by_priority;  // indexed by PriorityClass
+        std::unordered_map<ResourceTypeId, std::unique_ptr<LatencyHistogram>> by_resource;
+    };
+    std::array<LatencySet, 3> latency_;  // indexed by LatencyMetric
+    mutable std::shared_mutex latency_mutex_;
+
+    void record_latency(LatencyMetric metric, const MonitorEvent& event);
 };
 
-// Fan-out to multiple monitors
+// Fan-out to multiple monitors. Owners cache subscribed_events() when a
+// monitor is installed, so ResourceManager::set_monitor() freezes the
+// composite: add every child first, since add_monitor() throws
+// std::logic_error afterwards.
 class CompositeMonitor : public Monitor {
 public:
     void add_monitor(std::shared_ptr<Monitor> monitor);
+    // Fixes the children, and those of nested composites
+    void freeze();
+    bool frozen() const noexcept { return frozen_.load(); }
 
     void on_event(const MonitorEvent& event) override;
     void on_snapshot(const SystemSnapshot& snapshot) override;
+    EventMask subscribed_events() const override;      // union of children
+    bool consumes_durations() const override;
 
 private:
     std::vector<std::shared_ptr<Monitor>> monitors_;
+    std::vector<EventMask> masks_;  // parallel to monitors_
+    std::atomic<bool> frozen_{false};
 };
 
 } // namespace agentguard
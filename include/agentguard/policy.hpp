@@ -17,6 +17,10 @@ public:
         const SystemSnapshot& current_state) const = 0;
 
     virtual std::string name() const = 0;
+
+    // Whether prioritize() reads current_state. Policies that return false
+    // are passed an empty snapshot, so the caller can skip building one.
+    virtual bool uses_snapshot() const { return true; }
 };
 
 // First-come, first-served (default)
@@ -26,6 +30,7 @@ public:
         const std::vector<ResourceRequest>& pending_requests,
         const SystemSnapshot& current_state) const override;
     std::string name() const override { return "FIFO"; }
+    bool uses_snapshot() const override { return false; }
 };
 
 // Higher priority agents get served first
@@ -35,6 +40,7 @@ public:
         const std::vector<ResourceRequest>& pending_requests,
         const SystemSnapshot& current_state) const override;
     std::string name() const override { return "Priority"; }
+    bool uses_snapshot() const override { return false; }
 };
 
 // Prefer agents closest to finishing (maximizes throughput)
@@ -53,6 +59,7 @@ public:
         const std::vector<ResourceRequest>& pending_requests,
         const SystemSnapshot& current_state) const override;
     std::string name() const override { return "DeadlineAware"; }
+    bool uses_snapshot() const override { return false; }
 };
 
 // Prevents starvation by preferring agents that have waited the longest
@@ -62,6 +69,7 @@ public:
         const std::vector<ResourceRequest>& pending_requests,
         const SystemSnapshot& current_state) const override;
     std::string name() const override { return "Fairness"; }
+    bool uses_snapshot() const override { return false; }
 };
 
 } // namespace agentguard
@@ -62,10 +62,14 @@ private:
     std::mutex cv_mutex_;
     std::condition_variable cv_;
     std::shared_ptr<Monitor> monitor_;
+    std::atomic<EventMask> event_mask_{0};  // monitor_'s subscriptions
     StallActionCallback stall_action_;
 
     void check_loop();
     void check_for_stalls();
+    bool wants_event(EventType type) const noexcept {
+        return (event_mask_.load(std::memory_order_relaxed) & event_bit(type)) != 0;
+    }
     void emit_event(EventType type, const std::string& message, AgentId agent_id);
 };
 
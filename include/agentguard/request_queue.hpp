@@ -1,11 +1,16 @@
 #pragma once
 
 #include "agentguard/types.hpp"
+#include "agentguard/executor.hpp"
 
 #include <algorithm>
 #include <condition_variable>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace agentguard {
@@ -14,6 +19,12 @@ class RequestQueue {
 public:
     explicit RequestQueue(std::size_t max_queue_size = 10000);
 
+    // Where the cancel methods and expire_timed_out() run the
+    // callbacks of the requests they remove. Callbacks always run after the
+    // queue lock is released; with no executor they run on the calling
+    // thread before the method returns.
+    void set_executor(std::shared_ptr<Executor> executor);
+
     // Enqueue a new resource request. Assigns and returns the RequestId.
     RequestId enqueue(ResourceRequest request);
 
@@ -26,18 +37,48 @@ public:
     // Cancel a specific request.
     bool cancel(RequestId id);
 
+    // Remove a request that was satisfied elsewhere. Unlike cancel(), the
+    // request's callback is not invoked.
+    bool remove(RequestId id);
+
+    // Look up a pending request by id.
+    std::optional<ResourceRequest> find(RequestId id) const;
+
     // Cancel all requests from a specific agent. Returns count removed.
+    // Proportional to that agent's pending requests.
     std::size_t cancel_all_for_agent(AgentId agent_id);
 
+    // Cancel every pending request. Returns count removed.
+    std::size_t cancel_all();
+
     // Get all pending requests (snapshot).
     std::vector<ResourceRequest> get_all_pending() const;
 
-    // Get pending requests for a specific resource type.
+    // Get pending requests for a specific resource type, in queue order,
+    // including multi-resource requests with a part on it.
+    // Proportional to that resource's pending requests.
     std::vector<ResourceRequest> get_pending_for_resource(ResourceTypeId rt) const;
 
     // Expire timed-out requests. Returns the expired request IDs.
+    // Proportional to the number of requests that expired.
     std::vector<RequestId> expire_timed_out();
 
+    // Earliest deadline (submitted_at + timeout) among pending requests.
+    std::optional<Timestamp> next_deadline() const;
+
+    // Remove from the starvation watch, and return, every request submitted
+    // at or before cutoff, oldest first. Each request is returned at most
+    // once. Proportional to the number returned.
+    std::vector<ResourceRequest> take_starved(Timestamp cutoff);
+
+    // Submission time of the oldest request still on the starvation watch.
+    std::optional<Timestamp> oldest_unreported() const;
+
+    // Raise a pending request's priority by delta (saturating) and move it
+    // to its new queue position. Returns the new priority, or nullopt if
+    // the request is gone.
+    std::optional<Priority> boost_priority(RequestId id, Priority delta);
+
     // Size and capacity.
     std::size_t size() const;
     bool empty() const;
@@ -51,20 +92,50 @@ public:
     void notify();
 
 private:
+    // Ordering key: higher priority first, then earlier submission, then
+    // lower id, which reproduces a stable priority-then-FIFO order exactly.
+    struct OrderKey {
+        Priority priority;
+        Timestamp submitted_at;
+        RequestId id;
+
+        bool operator<(const OrderKey& other) const noexcept {
+            if (priority != other.priority) return priority > other.priority;
+            if (submitted_at != other.submitted_at) return submitted_at < other.submitted_at;
+            return id < other.id;
+        }
+    };
+    using OrderedRequests = std::map<OrderKey, ResourceRequest>;
+    using OrderedIds = std::set<OrderKey>;
+
+    // A removed request's callback, to be run once the lock is released
+    struct Completion {
+        RequestCallback callback;
+        RequestId id;
+        RequestStatus status;
+    };
+
     mutable std::mutex mutex_;
     std::condition_variable cv_;
     std::size_t max_queue_size_;
-
-    // Sorted vector (priority desc, then submission time asc)
-    std::vector<ResourceRequest> requests_;
-
+    std::shared_ptr<Executor> executor_;
+
+    OrderedRequests requests_;
+    std::unordered_map<RequestId, OrderedRequests::iterator> by_id_;
+    std::unordered_map<ResourceTypeId, OrderedIds> by_resource_;
+    std::unordered_map<AgentId, OrderedIds> by_agent_;
+    std::set<std::pair<Timestamp, RequestId>> deadlines_;
+    std::set<std::pair<Timestamp, RequestId>> unreported_;  // by submission time
     RequestId next_request_id_{1};
 
-    // Compare for ordering: higher priority first, then earlier submission
-    static bool compare(const ResourceRequest& a, const ResourceRequest& b);
-
-    // Resort after modification
-    void sort_requests();
+    // Insert a request that already has its id and submission time.
+    void insert(ResourceRequest request);
+    // Remove an entry from the ordered map and every index.
+    OrderedRequests::iterator erase(OrderedRequests::iterator it);
+    // Remove an entry from every index, leaving it in the ordered map.
+    void unindex(OrderedRequests::const_iterator it);
+    ResourceRequest pop_front();
+    static void complete(std::vector<Completion>& done, const std::shared_ptr<Executor>& executor);
 };
 
 } // namespace agentguard
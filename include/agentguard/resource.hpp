@@ -20,14 +20,19 @@ public:
     ResourceCategory category() const noexcept;
     ResourceQuantity total_capacity() const noexcept;
     ResourceQuantity allocated() const noexcept;
+    // Units consumed by agents and not yet replenished
+    ResourceQuantity consumed() const noexcept;
     ResourceQuantity available() const noexcept;
 
-    // Dynamic capacity adjustment. Returns false if new_capacity < allocated.
+    // Dynamic capacity adjustment. Returns false if new_capacity is below
+    // allocated plus consumed.
     bool set_total_capacity(ResourceQuantity new_capacity);
 
     // AI-specific metadata
     void set_replenish_interval(Duration interval);
     std::optional<Duration> replenish_interval() const noexcept;
+    void set_replenish_policy(ReplenishPolicy policy);
+    ReplenishPolicy replenish_policy() const noexcept;
 
     void set_cost_per_unit(double cost);
     std::optional<double> cost_per_unit() const noexcept;
@@ -38,13 +43,17 @@ private:
     ResourceCategory category_;
     ResourceQuantity total_capacity_;
     ResourceQuantity allocated_{0};
+    ResourceQuantity consumed_{0};
 
     std::optional<Duration> replenish_interval_;
+    ReplenishPolicy         replenish_policy_{ReplenishPolicy::SlidingWindow};
     std::optional<double>   cost_per_unit_;
 
-    // ResourceManager modifies allocated_
+    // ResourceManager modifies allocated_ and consumed_
     void allocate(ResourceQuantity qty);
     void deallocate(ResourceQuantity qty);
+    void consume(ResourceQuantity qty);    // allocated -> consumed
+    void replenish(ResourceQuantity qty);  // consumed -> available
 
     friend class ResourceManager;
 };
@@ -5,25 +5,35 @@
 #include "agentguard/agent.hpp"
 #include "agentguard/safety_checker.hpp"
 #include "agentguard/request_queue.hpp"
+#include "agentguard/executor.hpp"
 #include "agentguard/monitor.hpp"
 #include "agentguard/policy.hpp"
 #include "agentguard/config.hpp"
 #include "agentguard/progress_tracker.hpp"
 #include "agentguard/delegation_tracker.hpp"
 #include "agentguard/demand_estimator.hpp"
+#include "agentguard/timer_wheel.hpp"
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <future>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace agentguard {
 
+template <typename Resume>
+class AcquireAwaitable;  // agentguard/coroutine.hpp
+
 class ResourceManager {
 public:
     explicit ResourceManager(Config config = Config{});
@@ -63,8 +73,23 @@ public:
         const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
         std::optional<Duration> timeout = std::nullopt);
 
+    // Elastic request: grants the largest quantity in [min_quantity,
+    // max_quantity] that is available and keeps the state safe, waiting like
+    // request_resources() until at least min_quantity can be granted.
+    // max_quantity is capped by the remaining claim; min_quantity is not.
+    ElasticGrant request_resources_elastic(
+        AgentId agent_id,
+        ResourceTypeId resource_type,
+        ResourceQuantity min_quantity,
+        ResourceQuantity max_quantity,
+        std::optional<Duration> timeout = std::nullopt);
+
     // ==================== Asynchronous Resource Requests ====================
 
+    // Queued requests are resolved by the processor; those submitted before
+    // start() wait in the queue until it runs. stop() and destruction
+    // resolve whatever is still queued as Cancelled, and after stop() so are
+    // requests that cannot be granted at once, until start() again.
     std::future<RequestStatus> request_resources_async(
         AgentId agent_id,
         ResourceTypeId resource_type,
@@ -78,6 +103,19 @@ public:
         RequestCallback callback,
         std::optional<Duration> timeout = std::nullopt);
 
+    // All-or-nothing multi-resource requests resolved by the processor: the
+    // agent gets every resource in `requests` in one grant, or none
+    std::future<RequestStatus> request_resources_batch_async(
+        AgentId agent_id,
+        const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+        std::optional<Duration> timeout = std::nullopt);
+
+    RequestId request_resources_batch_callback(
+        AgentId agent_id,
+        const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+        RequestCallback callback,
+        std::optional<Duration> timeout = std::nullopt);
+
     // ==================== Resource Release ====================
 
     void release_resources(AgentId agent_id, ResourceTypeId resource_type,
@@ -85,11 +123,22 @@ public:
     void release_all_resources(AgentId agent_id, ResourceTypeId resource_type);
     void release_all_resources(AgentId agent_id);
 
+    // The agent has used up `quantity` of what it holds (API calls made,
+    // tokens spent). On a resource with a replenish interval the units leave
+    // its allocation but stay unavailable until the resource replenishes,
+    // per its ReplenishPolicy; refills run on the background processor. On
+    // any other resource this is release_resources().
+    void consume_resources(AgentId agent_id, ResourceTypeId resource_type,
+                           ResourceQuantity quantity);
+
     // ==================== Queries ====================
 
     bool is_safe() const;
     SystemSnapshot get_snapshot() const;
     std::size_t pending_request_count() const;
+    SafetyCacheStats safety_cache_stats() const;
+    // Times a blocked synchronous request woke up to re-check
+    std::uint64_t waiter_wakeups() const noexcept;
 
     // ==================== Progress Monitoring ====================
 
@@ -122,12 +171,22 @@ public:
 
     void set_scheduling_policy(std::unique_ptr<SchedulingPolicy> policy);
     void set_monitor(std::shared_ptr<Monitor> monitor);
+    // Waits until every event emitted so far has reached the monitor
+    // (only matters when config.async_monitor is enabled)
+    void flush_events();
+    // Runs completion callbacks of queued requests (grant, expiry,
+    // cancellation). Defaults per config.executor; set before start().
+    void set_executor(std::shared_ptr<Executor> executor);
+    const std::shared_ptr<Executor>& executor() const noexcept { return executor_; }
 
     void start();
     void stop();
     bool is_running() const noexcept;
 
 private:
+    template <typename Resume>
+    friend class AcquireAwaitable;
+
     Config config_;
 
     // Core state (Banker's Algorithm matrices)
@@ -135,39 +194,247 @@ private:
     std::unordered_map<ResourceTypeId, Resource> resources_;
     std::unordered_map<AgentId, Agent> agents_;
 
+    // Dense Banker's matrices, kept in step with resources_/agents_ on every
+    // mutation so grants never rebuild the safety state
+    SafetyMatrix safety_matrix_;
+
     // Sub-components
     SafetyChecker safety_checker_;
+
+    // Last safe sequence found for a granted state. Most grants leave the
+    // completion order unchanged, so replaying it usually proves the next
+    // grant safe without a search. Guarded by state_mutex_.
+    std::vector<AgentId> safe_sequence_;
+    std::atomic<std::uint64_t> safety_cache_hits_{0};
+    std::atomic<std::uint64_t> safety_cache_misses_{0};
+
+    // Known bounds on the largest safe grant per (agent row, resource
+    // column), indexed like the matrix cells and valid while stamped with the
+    // current epoch. Each safety check of a cell tightens them, so a request
+    // is only checked when it falls between the two. Grants and claim/capacity
+    // changes bump the epoch. Releases only void the upper bounds: freeing
+    // resources can make an unsafe grant safe but never the reverse.
+    // Guarded by state_mutex_.
+    struct HeadroomEntry {
+        std::uint64_t epoch{0};
+        ResourceQuantity safe{0};         // largest quantity known to be safe
+        ResourceQuantity unsafe_from{0};  // smallest known unsafe, valid while
+        std::uint64_t unsafe_stamp{0};    // this matches headroom_releases_
+    };
+    std::vector<HeadroomEntry> headroom_;
+    std::uint64_t headroom_epoch_{1};
+    std::uint64_t headroom_releases_{1};
+    std::atomic<std::uint64_t> headroom_hits_{0};
+    std::shared_ptr<Executor> executor_;
     RequestQueue request_queue_;
     std::unique_ptr<SchedulingPolicy> scheduling_policy_;
     std::shared_ptr<Monitor> monitor_;
+    // Captured from monitor_ in set_monitor(): which events to build and
+    // which of them to time (safety checks, grant waits, lock holds)
+    EventMask event_mask_{0};
+    EventMask timed_events_{0};
 
     // Novel subsystems
     std::unique_ptr<ProgressTracker> progress_tracker_;
     std::unique_ptr<DelegationTracker> delegation_tracker_;
     DemandEstimator demand_estimator_;
 
+    // Read model behind lookups, get_snapshot(), is_safe() and the snapshot
+    // thread, none of which take state_mutex_. Writers keep it current before
+    // releasing the exclusive lock (see PublishScope): each agent and
+    // resource has a cell holding an immutable copy, replaced whenever that
+    // entity changes, and the index of cells is only replaced when entities
+    // come or go. published_safe_ is the verdict for the published state.
+    // publish_seq_ is odd while a writer publishes, so a reader spanning
+    // several cells can tell whether it saw a single state.
+    template <typename T>
+    struct PublishedCell {
+        std::shared_ptr<const T> value;  // atomic access only
+    };
+    struct PublishedIndex {
+        std::unordered_map<ResourceTypeId, std::shared_ptr<PublishedCell<Resource>>> resources;
+        std::unordered_map<AgentId, std::shared_ptr<PublishedCell<Agent>>> agents;
+    };
+    class PublishScope;
+    std::shared_ptr<const PublishedIndex> published_ =
+        std::make_shared<const PublishedIndex>();  // atomic access only
+    std::atomic<std::uint64_t> publish_seq_{0};
+    std::atomic<bool> published_safe_{true};
+
+    // Group-commit admission (config_.admission). Arriving requests queue
+    // their first attempt; whichever thread finds no combiner running takes
+    // the role, evaluates queued attempts in one state_mutex_ hold and
+    // wakes their owners.
+    struct AdmissionSlot;
+    class SpanTimer;
+    std::mutex admission_mutex_;
+    std::condition_variable admission_cv_;   // slot done or combiner stepped down
+    std::condition_variable batch_full_cv_;  // combiner waiting out its window
+    std::vector<AdmissionSlot*> admission_queue_;
+    bool combining_{false};
+
     // Background processor
     std::thread processor_thread_;
     std::atomic<bool> running_{false};
-    std::condition_variable_any release_cv_;
+    std::atomic<bool> stopped_{false};  // stop() ran since the last start()
+
+    // Periodic on_snapshot() delivery while running (snapshot_interval > 0)
+    std::thread snapshot_thread_;
+    std::mutex snapshot_mutex_;
+    std::condition_variable snapshot_cv_;
+
+    // Blocked synchronous requests. Each waiter parks on its own slot, listed
+    // under every resource it asked for, so a release wakes only the waiters
+    // it can now satisfy (plus those refused as unsafe) instead of every
+    // blocked thread. Guarded by state_mutex_.
+    struct WaitSlot;
+    class WaiterScope;
+    std::unordered_map<ResourceTypeId, std::vector<WaitSlot*>> waiters_;
+    std::unordered_set<WaitSlot*> unsafe_waiters_;
+    std::atomic<std::uint64_t> waiter_wakeups_{0};
+
+    // What the processor has to re-examine on its next pass. Requests short
+    // on their own resource only become grantable when that resource is
+    // released; requests refused as unsafe can be unblocked by any release
+    // (state_released_), but not by an enqueue or a refill.
+    // The processor sleeps on processor_cv_ until one of these is set, a
+    // queued request's deadline passes, or stop() is called.
+    std::mutex pending_work_mutex_;
+    std::condition_variable processor_cv_;
+    std::unordered_set<ResourceTypeId> dirty_resources_;
+    bool state_released_{false};
+    bool rescan_all_{true};
+    std::unordered_set<RequestId> unsafe_blocked_;  // processor thread only
+
+    // Consumed units awaiting refill, per replenishing resource. Each such
+    // resource has at most one timer in replenish_wheel_, for its next
+    // refill; the processor sleeps until the wheel's next expiry, so idle
+    // limiters cost nothing. Guarded by state_mutex_.
+    struct ReplenishState {
+        // SlidingWindow: consumed batches in the order they come back
+        std::deque<std::pair<Timestamp, ResourceQuantity>> window;
+        // TokenBucket: accrual since last_refill, in fractions of a unit
+        Timestamp last_refill{};
+        double credit{0.0};
+        std::optional<Timestamp> armed_for;  // expiry of the pending timer
+    };
+    std::unordered_map<ResourceTypeId, ReplenishState> replenish_;
+    TimerWheel replenish_wheel_;
+    // replenish_wheel_.next_expiry() since the epoch, for the processor to
+    // read without the state lock (NO_REFILL when the wheel is empty)
+    static constexpr Duration::rep NO_REFILL = std::numeric_limits<Duration::rep>::max();
+    std::atomic<Duration::rep> next_refill_{NO_REFILL};
 
     // ID generators
     AgentId next_agent_id_{1};
 
     // Internal helpers
-    SafetyCheckInput build_safety_input() const;
+    // `checked`: the grant passed the Banker's check, so the state stays safe
+    void commit_allocation(Agent& agent, Resource& res, ResourceQuantity quantity,
+                           bool checked = true);
+    void commit_release(Agent& agent, Resource& res, ResourceQuantity quantity);
+    // Refill bookkeeping; callers hold state_mutex_ exclusively
+    ResourceQuantity refill(Resource& res, ReplenishState& state, Timestamp now);
+    void arm_replenish(const Resource& res, ReplenishState& state);
+    void publish_next_refill();
+    void replenish_due();  // processor thread
+    std::optional<Timestamp> next_replenish() const;
+    void sync_safety_cell(const Agent& agent, const Resource& res);
+    SafetyCheckResult check_grant(AgentId agent_id, ResourceTypeId resource_type,
+                                  ResourceQuantity quantity);
+    SafetyCheckResult verify_grant(AgentId agent_id, ResourceTypeId resource_type,
+                                   ResourceQuantity quantity);
+    // The cell's entry, reset if stale
+    HeadroomEntry& headroom_entry(std::size_t row, std::size_t col);
+    // verify_grant() that records its verdict in `entry`
+    SafetyCheckResult probe_headroom(HeadroomEntry& entry, AgentId agent_id,
+                                     ResourceTypeId resource_type, ResourceQuantity quantity);
+    void invalidate_headroom();
+    // Largest safe grant in [min_quantity, max_quantity] that fits what is
+    // available, or 0 if min_quantity does not fit
+    ResourceQuantity largest_safe_grant(AgentId agent_id, ResourceTypeId resource_type,
+                                        ResourceQuantity min_quantity,
+                                        ResourceQuantity max_quantity);
+    void validate_request(AgentId agent_id, ResourceTypeId resource_type,
+                          ResourceQuantity quantity) const;  // throws
+    // Submission and the first grant attempt, shared by the blocking and
+    // future-based paths; true if granted
+    bool admit_first(AgentId agent_id, ResourceTypeId resource_type,
+                     ResourceQuantity quantity, const SpanTimer& wait_timer);
+    void validate_batch(AgentId agent_id,
+                        const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests)
+        const;  // throws
+    // Safety of granting every part together; nullopt if some part is short.
+    // Caller holds state_mutex_ exclusively.
+    std::optional<SafetyCheckResult> check_bundle(AgentId agent_id,
+                                                  const std::vector<ResourceDemand>& parts);
+    bool admit_bundle(AgentId agent_id, const std::vector<ResourceDemand>& parts,
+                      const SpanTimer& wait_timer);
+    void admit(AdmissionSlot& slot);
+    void admit_locked(AdmissionSlot& slot);  // caller holds state_mutex_ exclusively
+    // Published cells copied into a snapshot (timestamp and queue length
+    // left to the caller)
+    SystemSnapshot read_published() const;
+    SystemSnapshot published_snapshot() const;
+    void wake_waiters(ResourceTypeId id);  // caller holds state_mutex_ exclusively
+    void wake_all_waiters();               // caller holds state_mutex_ exclusively
+    // Requests waiting on `id` get another look
+    void mark_resource_dirty(ResourceTypeId id);
+    // ...and so do those refused as unsafe: something was released, or a
+    // resource registered or grown
+    void mark_resource_freed(ResourceTypeId id);
+    void mark_rescan_all();
+    bool has_pending_work() const;  // caller holds pending_work_mutex_
+    std::vector<ResourceRequest> collect_pending_work();
     SafetyCheckInput build_adaptive_safety_input(double confidence_level) const;
     void process_queue_loop();
+    void snapshot_loop();
+    // Reports (and optionally boosts) newly starved queued requests;
+    // returns when the next one will cross the threshold
+    std::optional<Timestamp> detect_starvation();
     void try_grant_pending_requests();
-    bool try_grant_single(AgentId agent_id, ResourceTypeId resource_type,
-                          ResourceQuantity quantity);
-    void emit_event(EventType type, const std::string& message,
+    void try_grant_bundle(ResourceRequest& req);  // processor thread
+    // Resolve a just-parked async request if the processor has stopped
+    void cancel_if_stopped(RequestId id);
+    // The two halves of request_resources_async() and its batch form, shared
+    // with AcquireAwaitable: validation (throws) and one grant attempt, then
+    // parking the request with the default timeout applied
+    bool admit_now(AgentId agent_id, ResourceTypeId resource_type, ResourceQuantity quantity);
+    bool admit_now(AgentId agent_id,
+                   const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests);
+    void park(AgentId agent_id, ResourceTypeId resource_type, ResourceQuantity quantity,
+              RequestCallback callback, std::optional<Duration> timeout);
+    void park(AgentId agent_id,
+              const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+              RequestCallback callback, std::optional<Duration> timeout);
+    bool wants_event(EventType type) const noexcept {
+        return (event_mask_ & event_bit(type)) != 0;
+    }
+    bool wants_duration(EventType type) const noexcept {
+        return (timed_events_ & event_bit(type)) != 0;
+    }
+    void emit_event(EventType type, std::string_view message,
                     std::optional<AgentId> agent_id = std::nullopt,
                     std::optional<ResourceTypeId> resource_type = std::nullopt,
                     std::optional<RequestId> request_id = std::nullopt,
                     std::optional<ResourceQuantity> quantity = std::nullopt,
                     std::optional<bool> safety_result = std::nullopt,
-                    std::optional<double> duration_us = std::nullopt);
+                    std::optional<double> duration_us = std::nullopt,
+                    std::optional<Priority> priority = std::nullopt);
+    // The event emit_event() would deliver, or nullopt if the monitor does
+    // not want it. Events raised under state_mutex_ are built with this and
+    // delivered once the lock is released, so a slow monitor never extends a
+    // lock hold.
+    std::optional<MonitorEvent> make_event(
+        EventType type, std::string_view message,
+        std::optional<AgentId> agent_id = std::nullopt,
+        std::optional<ResourceTypeId> resource_type = std::nullopt,
+        std::optional<RequestId> request_id = std::nullopt,
+        std::optional<ResourceQuantity> quantity = std::nullopt,
+        std::optional<bool> safety_result = std::nullopt,
+        std::optional<double> duration_us = std::nullopt,
+        std::optional<Priority> priority = std::nullopt) const;
+    void emit_event(const std::optional<MonitorEvent>& event);
 };
 
 } // namespace agentguard
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "agentguard/types.hpp"
+#include "agentguard/safety_matrix.hpp"
+
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace agentguard {
 
-// Input to the safety check: a snapshot of current system state
+namespace detail { struct SafetyKernels; }
+
+// Input to the safety check: a snapshot of current system state.
+// Map-based form kept for convenience; checks convert it to a SafetyMatrix.
 struct SafetyCheckInput {
     // Total resources in the system per type
     std::unordered_map<ResourceTypeId, ResourceQuantity> total;
@@ -30,13 +35,35 @@ struct SafetyCheckResult {
     std::string reason;                  // Human-readable explanation (if unsafe)
 };
 
+// Dense overloads come in three flavours:
+//  - const SafetyMatrix&: the state is never touched (hypotheticals copy it).
+//  - SafetyMatrix&: the hypothetical grant is applied to the state in place,
+//    checked, and rolled back before returning. No copy is made; the state is
+//    unchanged afterwards but must not be read concurrently during the call.
+//  - SafetyCheckResult& out-parameter: the result's buffers are reused, so a
+//    caller that keeps one result around performs no heap allocation per
+//    check once it has warmed up.
+//
+// Both algorithms agree on whether a state is safe and on which agents are
+// stuck when it is not; they may report different (equally valid) safe
+// sequences.
 class SafetyChecker {
 public:
-    SafetyChecker() = default;
+    // use_simd_kernels picks the widest row kernels the CPU supports at
+    // runtime; false forces the portable scalar kernels.
+    explicit SafetyChecker(SafetyAlgorithm algorithm = SafetyAlgorithm::Classic,
+                           bool use_simd_kernels = true);
+
+    SafetyAlgorithm algorithm() const noexcept { return algorithm_; }
+
+    // Name of the row kernels in use: "scalar", "avx2" or "avx512"
+    const char* kernel_name() const noexcept;
 
     // Core Banker's Algorithm safety check.
     // Pure function: no side effects, no locking.
     SafetyCheckResult check_safety(const SafetyCheckInput& input) const;
+    SafetyCheckResult check_safety(const SafetyMatrix& state) const;
+    void check_safety(const SafetyMatrix& state, SafetyCheckResult& result) const;
 
     // "If we grant this request, is the resulting state safe?"
     SafetyCheckResult check_hypothetical(
@@ -44,16 +71,63 @@ public:
         AgentId requesting_agent,
         ResourceTypeId resource_type,
         ResourceQuantity quantity) const;
+    SafetyCheckResult check_hypothetical(
+        const SafetyMatrix& current_state,
+        AgentId requesting_agent,
+        ResourceTypeId resource_type,
+        ResourceQuantity quantity) const;
+
+    // The *_in_place forms skip the copy: they apply the grants to
+    // `current_state`, check, and undo them before returning (also when
+    // unwinding). The matrix is modified meanwhile, so the caller must own
+    // it exclusively. Unknown agents or resources fall back to a copy.
+    SafetyCheckResult check_hypothetical_in_place(
+        SafetyMatrix& current_state,
+        AgentId requesting_agent,
+        ResourceTypeId resource_type,
+        ResourceQuantity quantity) const;
+    void check_hypothetical_in_place(
+        SafetyMatrix& current_state,
+        AgentId requesting_agent,
+        ResourceTypeId resource_type,
+        ResourceQuantity quantity,
+        SafetyCheckResult& result) const;
+
+    // Replays a previously found completion order: a single pass with no
+    // search. True iff every active agent appears in the sequence and each
+    // can finish in that order, which proves the state safe. False says
+    // nothing either way; fall back to a full check. replay_hypothetical()
+    // grants in place like the *_in_place forms.
+    bool replay_sequence(const SafetyMatrix& state,
+                         const std::vector<AgentId>& sequence) const;
+    bool replay_hypothetical(
+        SafetyMatrix& current_state,
+        AgentId requesting_agent,
+        ResourceTypeId resource_type,
+        ResourceQuantity quantity,
+        const std::vector<AgentId>& sequence) const;
 
     // Check if granting multiple requests simultaneously is safe.
     SafetyCheckResult check_hypothetical_batch(
         const SafetyCheckInput& current_state,
         const std::vector<ResourceRequest>& requests) const;
+    SafetyCheckResult check_hypothetical_batch(
+        const SafetyMatrix& current_state,
+        const std::vector<ResourceRequest>& requests) const;
+    SafetyCheckResult check_hypothetical_batch_in_place(
+        SafetyMatrix& current_state,
+        const std::vector<ResourceRequest>& requests) const;
 
     // From a set of candidates, find which can be safely granted.
     std::vector<RequestId> find_grantable_requests(
         const SafetyCheckInput& current_state,
         const std::vector<ResourceRequest>& candidates) const;
+    std::vector<RequestId> find_grantable_requests(
+        const SafetyMatrix& current_state,
+        const std::vector<ResourceRequest>& candidates) const;
+    std::vector<RequestId> find_grantable_requests_in_place(
+        SafetyMatrix& current_state,
+        const std::vector<ResourceRequest>& candidates) const;
 
     // Identify agents whose remaining needs are closest to exhausting available resources.
     std::vector<AgentId> identify_bottleneck_agents(
@@ -75,6 +149,10 @@ public:
         ResourceTypeId resource,
         ResourceQuantity quantity,
         double confidence_level) const;
+
+private:
+    SafetyAlgorithm algorithm_;
+    const detail::SafetyKernels* kernels_;
 };
 
 } // namespace agentguard
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "agentguard/types.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace agentguard {
+
+struct SafetyCheckInput;
+
+// Dense form of the Banker's Algorithm matrices.
+//
+// Agents occupy rows and resource types occupy columns. Each row stores its
+// allocation, max-need and remaining-need cells contiguously (row-major, with
+// a column stride that may exceed the number of live columns), so the safety
+// loop walks flat arrays instead of nested hash maps.
+//
+// Slot indices are stable: removing an agent or resource frees its row or
+// column for reuse without moving any other slot, so callers may hold on to
+// indices between checks. Free slots and padding cells are all zero, which
+// makes them neutral in every safety computation.
+class SafetyMatrix {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    SafetyMatrix() = default;
+
+    // Adapters to and from the map-based representation.
+    static SafetyMatrix from_input(const SafetyCheckInput& input);
+    SafetyCheckInput to_input() const;
+
+    // Slot management. add_* returns the existing slot if already present.
+    std::size_t add_resource(ResourceTypeId id);
+    bool remove_resource(ResourceTypeId id);
+    std::size_t add_agent(AgentId id);
+    bool remove_agent(AgentId id);
+
+    std::size_t agent_slot(AgentId id) const noexcept;
+    std::size_t resource_slot(ResourceTypeId id) const noexcept;
+    AgentId agent_at(std::size_t row) const noexcept;
+    ResourceTypeId resource_at(std::size_t col) const noexcept;
+    bool row_active(std::size_t row) const noexcept;
+    bool column_active(std::size_t col) const noexcept;
+
+    std::size_t agent_count() const noexcept;
+    std::size_t resource_count() const noexcept;
+    std::size_t row_count() const noexcept;   // includes free rows
+    std::size_t stride() const noexcept;      // cells per row
+
+    // Cell access
+    ResourceQuantity total(std::size_t col) const noexcept;
+    ResourceQuantity available(std::size_t col) const noexcept;
+    ResourceQuantity allocation(std::size_t row, std::size_t col) const noexcept;
+    ResourceQuantity max_need(std::size_t row, std::size_t col) const noexcept;
+    ResourceQuantity need(std::size_t row, std::size_t col) const noexcept;
+
+    // Cell mutation. need is kept equal to max_need - allocation.
+    void set_total(std::size_t col, ResourceQuantity qty) noexcept;
+    void set_available(std::size_t col, ResourceQuantity qty) noexcept;
+    void set_max_need(std::size_t row, std::size_t col, ResourceQuantity qty) noexcept;
+    void set_allocation(std::size_t row, std::size_t col, ResourceQuantity qty) noexcept;
+
+    // Move qty units from available into the agent's allocation (negative
+    // qty moves them back).
+    void allocate(std::size_t row, std::size_t col, ResourceQuantity qty) noexcept;
+
+    // Raw row access (stride() cells each)
+    const ResourceQuantity* available_data() const noexcept;
+    const ResourceQuantity* allocation_row(std::size_t row) const noexcept;
+    const ResourceQuantity* need_row(std::size_t row) const noexcept;
+
+private:
+    std::size_t stride_{0};
+    std::size_t row_count_{0};
+    std::size_t agent_count_{0};
+    std::size_t resource_count_{0};
+
+    // Per-column state
+    std::vector<ResourceTypeId> resource_ids_;
+    std::vector<unsigned char> column_active_;
+    std::vector<ResourceQuantity> total_;
+    std::vector<ResourceQuantity> available_;
+    std::vector<std::size_t> free_columns_;
+
+    // Per-row state
+    std::vector<AgentId> agent_ids_;
+    std::vector<unsigned char> row_active_;
+    std::vector<std::size_t> free_rows_;
+
+    // Row-major cells (row_count_ * stride_)
+    std::vector<ResourceQuantity> allocation_;
+    std::vector<ResourceQuantity> max_need_;
+    std::vector<ResourceQuantity> need_;
+
+    std::unordered_map<AgentId, std::size_t> agent_slots_;
+    std::unordered_map<ResourceTypeId, std::size_t> resource_slots_;
+
+    void grow_columns();
+    std::size_t cell(std::size_t row, std::size_t col) const noexcept {
+        return row * stride_ + col;
+    }
+};
+
+} // namespace agentguard
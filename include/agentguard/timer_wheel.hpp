@@ -0,0 +1,53 @@
+#pragma once
+
+#include "agentguard/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace agentguard {
+
+// Hashed timing wheel: a ring of `slots` buckets, each `tick` wide. A timer
+// is filed in the bucket of its expiry tick (rounded up, so it never fires
+// early); timers more than one revolution out share a bucket with nearer
+// ones and are skipped until their lap comes round. Scheduling is O(1) and
+// advancing only visits the buckets of elapsed ticks, however many timers
+// are pending. Not thread-safe.
+class TimerWheel {
+public:
+    TimerWheel(Duration tick, std::size_t slots, Timestamp origin = Clock::now());
+
+    // Files `key` to fire at `when` (or the next tick, if already past).
+    // Returns true if it is now the earliest pending timer.
+    bool schedule(Timestamp when, std::uint64_t key);
+
+    // Removes and returns the keys of every timer due by `now`
+    std::vector<std::uint64_t> advance(Timestamp now);
+
+    // When advance() next has something to do: the earliest pending expiry,
+    // or the end of the current revolution if every timer lies past it
+    std::optional<Timestamp> next_expiry() const;
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    struct Timer {
+        std::uint64_t tick;
+        std::uint64_t key;
+    };
+
+    Duration tick_;
+    Timestamp origin_;
+    std::vector<std::vector<Timer>> buckets_;
+    std::uint64_t current_{0};   // first tick not yet advanced past
+    std::uint64_t earliest_{0};  // next tick advance() has work at (valid if size_ > 0)
+    std::size_t size_{0};
+
+    std::uint64_t tick_at(Timestamp t, bool round_up) const;
+    void find_earliest();
+};
+
+} // namespace agentguard
@@ -31,6 +31,16 @@ constexpr Priority PRIORITY_NORMAL   = 50;
 constexpr Priority PRIORITY_HIGH     = 100;
 constexpr Priority PRIORITY_CRITICAL = 200;
 
+// Priority bands, bounded below by the constants above
+enum class PriorityClass { Low, Normal, High, Critical };
+
+constexpr PriorityClass priority_class(Priority p) noexcept {
+    if (p >= PRIORITY_CRITICAL) return PriorityClass::Critical;
+    if (p >= PRIORITY_HIGH) return PriorityClass::High;
+    if (p >= PRIORITY_NORMAL) return PriorityClass::Normal;
+    return PriorityClass::Low;
+}
+
 // Request status
 enum class RequestStatus {
     Pending,
@@ -62,10 +72,22 @@ enum class ResourceCategory {
     Custom
 };
 
+// How a resource with a replenish interval regains consumed units
+enum class ReplenishPolicy {
+    SlidingWindow,  // each consumed unit returns one interval after it was consumed
+    TokenBucket     // consumed units return at a steady capacity-per-interval rate
+};
+
 // Callback types
 using RequestCallback = std::function<void(RequestId, RequestStatus)>;
 using AgentEventCallback = std::function<void(AgentId, AgentState)>;
 
+// One resource of a multi-resource request
+struct ResourceDemand {
+    ResourceTypeId   resource_type{0};
+    ResourceQuantity quantity{0};
+};
+
 // Resource request descriptor
 struct ResourceRequest {
     RequestId       id{0};
@@ -76,6 +98,18 @@ struct ResourceRequest {
     std::optional<Duration> timeout;
     RequestCallback callback;
     Timestamp       submitted_at{};
+    // Multi-resource request: every part is granted together or none is.
+    // resource_type/quantity mirror the first part. Empty for a
+    // single-resource request.
+    std::vector<ResourceDemand> bundle;
+
+    bool is_bundle() const noexcept { return !bundle.empty(); }
+};
+
+// Outcome of an elastic request (see ResourceManager::request_resources_elastic)
+struct ElasticGrant {
+    RequestStatus    status{RequestStatus::Pending};
+    ResourceQuantity granted{0};  // zero unless status is Granted
 };
 
 // Snapshot of one agent's allocation
@@ -98,6 +132,15 @@ struct SystemSnapshot {
     bool is_safe{true};
 };
 
+// How often the manager's safety caches spared a full safe-sequence search.
+// hits/misses count replays of the cached safe sequence; headroom_hits
+// counts grants decided by the headroom table without any safety check.
+struct SafetyCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t headroom_hits{0};
+};
+
 inline const char* to_string(RequestStatus s) {
     switch (s) {
         case RequestStatus::Pending:   return "Pending";
@@ -150,6 +193,12 @@ enum class DemandMode {
     Hybrid     // Statistical estimate capped by explicit declaration
 };
 
+// Algorithm used by SafetyChecker to search for a safe sequence
+enum class SafetyAlgorithm {
+    Classic,   // Round-based Banker's loop, O(n^2 * m) worst case
+    Worklist   // Per-resource blocked lists sorted by need, O(n * m log n)
+};
+
 // Probabilistic safety result
 struct ProbabilisticSafetyResult {
     bool is_safe{false};
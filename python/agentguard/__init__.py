@@ -6,20 +6,33 @@ from agentguard._agentguard import (
     AgentState,
     ResourceCategory,
     DemandMode,
+    SafetyAlgorithm,
     DelegationCycleAction,
+    EventOverflowPolicy,
     EventType,
     Verbosity,
+    PriorityClass,
+    LatencyMetric,
+    CallbackExecution,
+    ReplenishPolicy,
 
     # Config structs
     Config,
     ProgressConfig,
     DelegationConfig,
     AdaptiveConfig,
+    AdmissionConfig,
+    AsyncMonitorConfig,
+    ExecutorConfig,
+    ReplenishConfig,
 
     # Data structs
+    ElasticGrant,
+    ResourceDemand,
     ResourceRequest,
     AgentAllocationSnapshot,
     SystemSnapshot,
+    SafetyCacheStats,
     SafetyCheckInput,
     SafetyCheckResult,
     MonitorEvent,
@@ -29,18 +42,27 @@ from agentguard._agentguard import (
     UsageStats,
     ProgressRecord,
     Metrics,
+    LatencySummary,
+    ExecutorStats,
 
     # Core classes
     Resource,
     Agent,
     ResourceManager,
     SafetyChecker,
+    Executor,
+    InlineExecutor,
+    ThreadPoolExecutor,
 
     # Monitors
     Monitor,
     ConsoleMonitor,
     MetricsMonitor,
     CompositeMonitor,
+    AsyncMonitor,
+    event_bit,
+    event_mask,
+    ALL_EVENTS,
 
     # Policies
     SchedulingPolicy,
@@ -81,18 +103,25 @@ from agentguard._version import __version__
 __all__ = [
     # Enums
     "RequestStatus", "AgentState", "ResourceCategory", "DemandMode",
-    "DelegationCycleAction", "EventType", "Verbosity",
+    "SafetyAlgorithm", "DelegationCycleAction", "EventOverflowPolicy",
+    "EventType", "Verbosity", "PriorityClass", "LatencyMetric",
+    "CallbackExecution", "ReplenishPolicy",
     # Config
     "Config", "ProgressConfig", "DelegationConfig", "AdaptiveConfig",
+    "AdmissionConfig", "AsyncMonitorConfig", "ExecutorConfig", "ReplenishConfig",
     # Data structs
-    "ResourceRequest", "AgentAllocationSnapshot", "SystemSnapshot",
+    "ElasticGrant", "ResourceDemand", "ResourceRequest", "AgentAllocationSnapshot", "SystemSnapshot",
+    "SafetyCacheStats",
     "SafetyCheckInput", "SafetyCheckResult", "MonitorEvent",
     "DelegationInfo", "DelegationResult", "ProbabilisticSafetyResult",
-    "UsageStats", "ProgressRecord", "Metrics",
+    "UsageStats", "ProgressRecord", "Metrics", "LatencySummary",
+    "ExecutorStats",
     # Core
     "Resource", "Agent", "ResourceManager", "SafetyChecker",
+    "Executor", "InlineExecutor", "ThreadPoolExecutor",
     # Monitors
     "Monitor", "ConsoleMonitor", "MetricsMonitor", "CompositeMonitor",
+    "AsyncMonitor", "event_bit", "event_mask", "ALL_EVENTS",
     # Policies
     "SchedulingPolicy", "FifoPolicy", "PriorityPolicy",
     "ShortestNeedPolicy", "DeadlinePolicy", "FairnessPolicy",
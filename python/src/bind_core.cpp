@@ -40,6 +40,7 @@ void bind_core(py::module_& m) {
         .def("category",       &Resource::category)
         .def("total_capacity", &Resource::total_capacity)
         .def("allocated",      &Resource::allocated)
+        .def("consumed",       &Resource::consumed)
         .def("available",      &Resource::available)
         // Setters / metadata
         .def("set_total_capacity",    &Resource::set_total_capacity,
@@ -47,6 +48,9 @@ void bind_core(py::module_& m) {
         .def("set_replenish_interval",&Resource::set_replenish_interval,
              py::arg("interval"))
         .def("replenish_interval",    &Resource::replenish_interval)
+        .def("set_replenish_policy",  &Resource::set_replenish_policy,
+             py::arg("policy"))
+        .def("replenish_policy",      &Resource::replenish_policy)
         .def("set_cost_per_unit",     &Resource::set_cost_per_unit,
              py::arg("cost"))
         .def("cost_per_unit",         &Resource::cost_per_unit)
@@ -104,6 +108,18 @@ void bind_core(py::module_& m) {
     // ===================================================================
     // ResourceManager
     // ===================================================================
+    // ===================================================================
+    // Executors (completion callbacks run on these)
+    // ===================================================================
+    py::class_<Executor, std::shared_ptr<Executor>>(m, "Executor");
+    py::class_<InlineExecutor, Executor, std::shared_ptr<InlineExecutor>>(m, "InlineExecutor")
+        .def(py::init<>());
+    py::class_<ThreadPoolExecutor, Executor, std::shared_ptr<ThreadPoolExecutor>>(
+            m, "ThreadPoolExecutor")
+        .def(py::init<std::size_t>(), py::arg("threads") = 0)
+        .def_property_readonly("thread_count", &ThreadPoolExecutor::thread_count)
+        .def("stats", &ThreadPoolExecutor::stats);
+
     py::class_<ResourceManager>(m, "ResourceManager")
         .def(py::init<Config>(), py::arg("config") = Config{})
 
@@ -139,6 +155,11 @@ void bind_core(py::module_& m) {
              py::arg("agent_id"), py::arg("requests"),
              py::arg("timeout") = std::nullopt,
              py::call_guard<py::gil_scoped_release>())
+        .def("request_resources_elastic", &ResourceManager::request_resources_elastic,
+             py::arg("agent_id"), py::arg("resource_type"),
+             py::arg("min_quantity"), py::arg("max_quantity"),
+             py::arg("timeout") = std::nullopt,
+             py::call_guard<py::gil_scoped_release>())
 
         // ------------- Asynchronous Resource Requests -------------
         .def("request_resources_async",
@@ -149,6 +170,14 @@ void bind_core(py::module_& m) {
              },
              py::arg("agent_id"), py::arg("resource_type"),
              py::arg("quantity"), py::arg("timeout") = std::nullopt)
+        .def("request_resources_batch_async",
+             [](ResourceManager& self, AgentId aid,
+                const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+                std::optional<Duration> timeout) {
+                 return FutureRequestStatus{
+                     self.request_resources_batch_async(aid, requests, timeout)};
+             },
+             py::arg("agent_id"), py::arg("requests"), py::arg("timeout") = std::nullopt)
 
         // ------------- Callback Resource Requests -------------
         .def("request_resources_callback",
@@ -166,10 +195,26 @@ void bind_core(py::module_& m) {
              py::arg("agent_id"), py::arg("resource_type"),
              py::arg("quantity"), py::arg("callback"),
              py::arg("timeout") = std::nullopt)
+        .def("request_resources_batch_callback",
+             [](ResourceManager& self, AgentId agent_id,
+                const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+                py::function callback, std::optional<Duration> timeout) -> RequestId {
+                 RequestCallback cpp_cb = [cb = py::object(callback)](
+                     RequestId id, RequestStatus status) {
+                     py::gil_scoped_acquire acquire;
+                     cb(id, status);
+                 };
+                 return self.request_resources_batch_callback(
+                     agent_id, requests, std::move(cpp_cb), timeout);
+             },
+             py::arg("agent_id"), py::arg("requests"), py::arg("callback"),
+             py::arg("timeout") = std::nullopt)
 
         // ------------- Resource Release -------------
         .def("release_resources", &ResourceManager::release_resources,
              py::arg("agent_id"), py::arg("resource_type"), py::arg("quantity"))
+        .def("consume_resources", &ResourceManager::consume_resources,
+             py::arg("agent_id"), py::arg("resource_type"), py::arg("quantity"))
         .def("release_all_resources",
              py::overload_cast<AgentId, ResourceTypeId>(
                  &ResourceManager::release_all_resources),
@@ -183,6 +228,8 @@ void bind_core(py::module_& m) {
         .def("is_safe",               &ResourceManager::is_safe)
         .def("get_snapshot",          &ResourceManager::get_snapshot)
         .def("pending_request_count", &ResourceManager::pending_request_count)
+        .def("safety_cache_stats",    &ResourceManager::safety_cache_stats)
+        .def("waiter_wakeups",        &ResourceManager::waiter_wakeups)
 
         // ------------- Progress Monitoring -------------
         .def("report_progress", &ResourceManager::report_progress,
@@ -223,6 +270,11 @@ void bind_core(py::module_& m) {
         // ------------- Configuration / Lifecycle -------------
         .def("set_monitor", &ResourceManager::set_monitor,
              py::arg("monitor"))
+        .def("flush_events", &ResourceManager::flush_events,
+             py::call_guard<py::gil_scoped_release>())
+        .def("set_executor", &ResourceManager::set_executor,
+             py::arg("executor"))
+        .def_property_readonly("executor", &ResourceManager::executor)
         .def("set_scheduling_policy",
              [](ResourceManager& self, std::shared_ptr<SchedulingPolicy> policy) {
                  // Bridge shared_ptr (pybind11 holder) to unique_ptr (C++ API)
@@ -241,6 +293,7 @@ void bind_core(py::module_& m) {
              },
              py::arg("policy"))
         .def("start",      &ResourceManager::start)
-        .def("stop",       &ResourceManager::stop)
+        .def("stop",       &ResourceManager::stop,
+             py::call_guard<py::gil_scoped_release>())
         .def("is_running", &ResourceManager::is_running);
 }
@@ -20,6 +20,16 @@ public:
         py::gil_scoped_acquire acquire;
         PYBIND11_OVERRIDE_PURE(void, Monitor, on_snapshot, snapshot);
     }
+
+    EventMask subscribed_events() const override {
+        py::gil_scoped_acquire acquire;
+        PYBIND11_OVERRIDE(EventMask, Monitor, subscribed_events);
+    }
+
+    bool consumes_durations() const override {
+        py::gil_scoped_acquire acquire;
+        PYBIND11_OVERRIDE(bool, Monitor, consumes_durations);
+    }
 };
 
 void bind_monitors(py::module_& m) {
@@ -27,7 +37,18 @@ void bind_monitors(py::module_& m) {
     py::class_<Monitor, PyMonitor, std::shared_ptr<Monitor>>(m, "Monitor")
         .def(py::init<>())
         .def("on_event", &Monitor::on_event)
-        .def("on_snapshot", &Monitor::on_snapshot);
+        .def("on_snapshot", &Monitor::on_snapshot)
+        .def("subscribed_events", &Monitor::subscribed_events)
+        .def("consumes_durations", &Monitor::consumes_durations);
+
+    // --- Event masks ---
+    m.def("event_bit", &event_bit, py::arg("type"));
+    m.def("event_mask", [](const std::vector<EventType>& types) {
+        EventMask mask = 0;
+        for (EventType t : types) mask |= event_bit(t);
+        return mask;
+    }, py::arg("types"));
+    m.attr("ALL_EVENTS") = ALL_EVENTS;
 
     // --- ConsoleMonitor ---
     py::class_<ConsoleMonitor, Monitor, std::shared_ptr<ConsoleMonitor>>(m, "ConsoleMonitor")
@@ -41,6 +62,11 @@ void bind_monitors(py::module_& m) {
         .def(py::init<>())
         .def("get_metrics", &MetricsMonitor::get_metrics)
         .def("reset_metrics", &MetricsMonitor::reset_metrics)
+        .def("latency", &MetricsMonitor::latency, py::arg("metric"))
+        .def("latency_for_resource", &MetricsMonitor::latency_for_resource,
+             py::arg("metric"), py::arg("resource_type"))
+        .def("latency_for_priority", &MetricsMonitor::latency_for_priority,
+             py::arg("metric"), py::arg("priority_class"))
         .def("set_utilization_alert_threshold",
             [](MetricsMonitor& self, double threshold, py::function cb) {
                 MetricsMonitor::AlertCallback cpp_cb =
@@ -64,8 +90,20 @@ void bind_monitors(py::module_& m) {
 
     // MetricsMonitor::Metrics is bound in bindings.cpp as "Metrics"
 
+    // --- AsyncMonitor ---
+    // flush() waits on the dispatcher, which needs the GIL to reach a
+    // Python monitor, so it runs with the GIL released
+    py::class_<AsyncMonitor, Monitor, std::shared_ptr<AsyncMonitor>>(m, "AsyncMonitor")
+        .def(py::init<std::shared_ptr<Monitor>, AsyncMonitorConfig>(),
+             py::arg("inner"), py::arg("config") = AsyncMonitorConfig{})
+        .def("flush", &AsyncMonitor::flush, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("dropped_events", &AsyncMonitor::dropped_events)
+        .def_property_readonly("capacity", &AsyncMonitor::capacity);
+
     // --- CompositeMonitor ---
     py::class_<CompositeMonitor, Monitor, std::shared_ptr<CompositeMonitor>>(m, "CompositeMonitor")
         .def(py::init<>())
-        .def("add_monitor", &CompositeMonitor::add_monitor);
+        .def("add_monitor", &CompositeMonitor::add_monitor)
+        .def("freeze", &CompositeMonitor::freeze)
+        .def_property_readonly("frozen", &CompositeMonitor::frozen);
 }
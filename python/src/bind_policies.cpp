@@ -21,6 +21,11 @@ public:
         py::gil_scoped_acquire acquire;
         PYBIND11_OVERRIDE_PURE(std::string, SchedulingPolicy, name);
     }
+
+    bool uses_snapshot() const override {
+        py::gil_scoped_acquire acquire;
+        PYBIND11_OVERRIDE(bool, SchedulingPolicy, uses_snapshot);
+    }
 };
 
 void bind_policies(py::module_& m) {
@@ -29,7 +34,8 @@ void bind_policies(py::module_& m) {
             m, "SchedulingPolicy")
         .def(py::init<>())
         .def("prioritize", &SchedulingPolicy::prioritize)
-        .def("name", &SchedulingPolicy::name);
+        .def("name", &SchedulingPolicy::name)
+        .def("uses_snapshot", &SchedulingPolicy::uses_snapshot);
 
     // --- Concrete policies ---
 
@@ -8,18 +8,33 @@ using namespace agentguard;
 void bind_subsystems(py::module_& m) {
     // SafetyChecker - stateless, all methods are const
     py::class_<SafetyChecker>(m, "SafetyChecker")
-        .def(py::init<>())
-        .def("check_safety", &SafetyChecker::check_safety,
+        .def(py::init<SafetyAlgorithm, bool>(),
+             py::arg("algorithm") = SafetyAlgorithm::Classic,
+             py::arg("use_simd_kernels") = true)
+        .def_property_readonly("algorithm", &SafetyChecker::algorithm)
+        .def_property_readonly("kernel_name", &SafetyChecker::kernel_name)
+        .def("check_safety",
+             py::overload_cast<const SafetyCheckInput&>(
+                 &SafetyChecker::check_safety, py::const_),
              py::arg("input"))
-        .def("check_hypothetical", &SafetyChecker::check_hypothetical,
+        .def("check_hypothetical",
+             py::overload_cast<const SafetyCheckInput&, AgentId, ResourceTypeId,
+                               ResourceQuantity>(
+                 &SafetyChecker::check_hypothetical, py::const_),
              py::arg("current_state"),
              py::arg("requesting_agent"),
              py::arg("resource_type"),
              py::arg("quantity"))
-        .def("check_hypothetical_batch", &SafetyChecker::check_hypothetical_batch,
+        .def("check_hypothetical_batch",
+             py::overload_cast<const SafetyCheckInput&,
+                               const std::vector<ResourceRequest>&>(
+                 &SafetyChecker::check_hypothetical_batch, py::const_),
              py::arg("current_state"),
              py::arg("requests"))
-        .def("find_grantable_requests", &SafetyChecker::find_grantable_requests,
+        .def("find_grantable_requests",
+             py::overload_cast<const SafetyCheckInput&,
+                               const std::vector<ResourceRequest>&>(
+                 &SafetyChecker::find_grantable_requests, py::const_),
              py::arg("current_state"),
              py::arg("candidates"))
         .def("identify_bottleneck_agents", &SafetyChecker::identify_bottleneck_agents,
@@ -65,6 +65,24 @@ void bind_enums_and_structs(py::module_& m) {
         .value("Hybrid",   DemandMode::Hybrid)
         .export_values();
 
+    py::enum_<SafetyAlgorithm>(m, "SafetyAlgorithm")
+        .value("Classic",  SafetyAlgorithm::Classic)
+        .value("Worklist", SafetyAlgorithm::Worklist)
+        .export_values();
+
+    py::enum_<EventOverflowPolicy>(m, "EventOverflowPolicy")
+        .value("Drop",   EventOverflowPolicy::Drop)
+        .value("Block",  EventOverflowPolicy::Block)
+        .value("Sample", EventOverflowPolicy::Sample);
+
+    py::enum_<ReplenishPolicy>(m, "ReplenishPolicy")
+        .value("SlidingWindow", ReplenishPolicy::SlidingWindow)
+        .value("TokenBucket",   ReplenishPolicy::TokenBucket);
+
+    py::enum_<CallbackExecution>(m, "CallbackExecution")
+        .value("ThreadPool", CallbackExecution::ThreadPool)
+        .value("Inline",     CallbackExecution::Inline);
+
     py::enum_<DelegationCycleAction>(m, "DelegationCycleAction")
         .value("NotifyOnly",       DelegationCycleAction::NotifyOnly)
         .value("RejectDelegation", DelegationCycleAction::RejectDelegation)
@@ -96,8 +114,23 @@ void bind_enums_and_structs(py::module_& m) {
         .value("DemandEstimateUpdated",     EventType::DemandEstimateUpdated)
         .value("ProbabilisticSafetyCheck",  EventType::ProbabilisticSafetyCheck)
         .value("AdaptiveDemandModeChanged", EventType::AdaptiveDemandModeChanged)
+        .value("LockHeld",                  EventType::LockHeld)
+        .value("RequestStarved",            EventType::RequestStarved)
+        .value("ResourcesConsumed",         EventType::ResourcesConsumed)
+        .value("ResourcesReplenished",      EventType::ResourcesReplenished)
         .export_values();
 
+    py::enum_<PriorityClass>(m, "PriorityClass")
+        .value("Low",      PriorityClass::Low)
+        .value("Normal",   PriorityClass::Normal)
+        .value("High",     PriorityClass::High)
+        .value("Critical", PriorityClass::Critical);
+
+    py::enum_<LatencyMetric>(m, "LatencyMetric")
+        .value("Wait",        LatencyMetric::Wait)
+        .value("SafetyCheck", LatencyMetric::SafetyCheck)
+        .value("LockHold",    LatencyMetric::LockHold);
+
     py::enum_<ConsoleMonitor::Verbosity>(m, "Verbosity")
         .value("Quiet",   ConsoleMonitor::Verbosity::Quiet)
         .value("Normal",  ConsoleMonitor::Verbosity::Normal)
@@ -132,7 +165,34 @@ void bind_enums_and_structs(py::module_& m) {
         .def_readwrite("adaptive_headroom_factor",   &AdaptiveConfig::adaptive_headroom_factor)
         .def_readwrite("default_demand_mode",        &AdaptiveConfig::default_demand_mode);
 
-    // Config (top-level, embeds the three sub-configs)
+    // AsyncMonitorConfig
+    py::class_<AsyncMonitorConfig>(m, "AsyncMonitorConfig")
+        .def(py::init<>())
+        .def_readwrite("enabled",      &AsyncMonitorConfig::enabled)
+        .def_readwrite("capacity",     &AsyncMonitorConfig::capacity)
+        .def_readwrite("overflow",     &AsyncMonitorConfig::overflow)
+        .def_readwrite("sample_every", &AsyncMonitorConfig::sample_every);
+
+    // AdmissionConfig
+    py::class_<AdmissionConfig>(m, "AdmissionConfig")
+        .def(py::init<>())
+        .def_readwrite("group_commit", &AdmissionConfig::group_commit)
+        .def_readwrite("window",       &AdmissionConfig::window)
+        .def_readwrite("max_batch",    &AdmissionConfig::max_batch);
+
+    // ExecutorConfig
+    py::class_<ExecutorConfig>(m, "ExecutorConfig")
+        .def(py::init<>())
+        .def_readwrite("mode",    &ExecutorConfig::mode)
+        .def_readwrite("threads", &ExecutorConfig::threads);
+
+    // ReplenishConfig
+    py::class_<ReplenishConfig>(m, "ReplenishConfig")
+        .def(py::init<>())
+        .def_readwrite("tick",        &ReplenishConfig::tick)
+        .def_readwrite("wheel_slots", &ReplenishConfig::wheel_slots);
+
+    // Config (top-level, embeds the sub-configs)
     py::class_<Config>(m, "Config")
         .def(py::init<>())
         .def_readwrite("max_agents",                &Config::max_agents)
@@ -143,10 +203,19 @@ void bind_enums_and_structs(py::module_& m) {
         .def_readwrite("snapshot_interval",         &Config::snapshot_interval)
         .def_readwrite("enable_timeout_expiration", &Config::enable_timeout_expiration)
         .def_readwrite("starvation_threshold",      &Config::starvation_threshold)
+        .def_readwrite("starvation_priority_boost", &Config::starvation_priority_boost)
         .def_readwrite("thread_safe",               &Config::thread_safe)
+        .def_readwrite("safety_algorithm",          &Config::safety_algorithm)
+        .def_readwrite("use_simd_kernels",          &Config::use_simd_kernels)
+        .def_readwrite("reuse_safe_sequence",       &Config::reuse_safe_sequence)
+        .def_readwrite("cache_grant_headroom",      &Config::cache_grant_headroom)
         .def_readwrite("progress",                  &Config::progress)
         .def_readwrite("delegation",                &Config::delegation)
-        .def_readwrite("adaptive",                  &Config::adaptive);
+        .def_readwrite("adaptive",                  &Config::adaptive)
+        .def_readwrite("admission",                 &Config::admission)
+        .def_readwrite("async_monitor",             &Config::async_monitor)
+        .def_readwrite("executor",                  &Config::executor)
+        .def_readwrite("replenish",                 &Config::replenish);
 
     // SafetyCheckInput
     py::class_<SafetyCheckInput>(m, "SafetyCheckInput")
@@ -175,7 +244,9 @@ void bind_enums_and_structs(py::module_& m) {
         .def_readwrite("quantity",        &MonitorEvent::quantity)
         .def_readwrite("safety_result",   &MonitorEvent::safety_result)
         .def_readwrite("target_agent_id", &MonitorEvent::target_agent_id)
-        .def_readwrite("cycle_path",      &MonitorEvent::cycle_path);
+        .def_readwrite("cycle_path",      &MonitorEvent::cycle_path)
+        .def_readwrite("duration_us",     &MonitorEvent::duration_us)
+        .def_readwrite("priority",        &MonitorEvent::priority);
 
     // SystemSnapshot
     py::class_<SystemSnapshot>(m, "SystemSnapshot")
@@ -187,6 +258,13 @@ void bind_enums_and_structs(py::module_& m) {
         .def_readwrite("pending_requests",    &SystemSnapshot::pending_requests)
         .def_readwrite("is_safe",             &SystemSnapshot::is_safe);
 
+    // SafetyCacheStats
+    py::class_<SafetyCacheStats>(m, "SafetyCacheStats")
+        .def(py::init<>())
+        .def_readwrite("hits",   &SafetyCacheStats::hits)
+        .def_readwrite("misses", &SafetyCacheStats::misses)
+        .def_readwrite("headroom_hits", &SafetyCacheStats::headroom_hits);
+
     // AgentAllocationSnapshot
     py::class_<AgentAllocationSnapshot>(m, "AgentAllocationSnapshot")
         .def(py::init<>())
@@ -245,6 +323,18 @@ void bind_enums_and_structs(py::module_& m) {
         .def_readwrite("stall_threshold", &ProgressRecord::stall_threshold)
         .def_readwrite("is_stalled",      &ProgressRecord::is_stalled);
 
+    // ElasticGrant
+    py::class_<ElasticGrant>(m, "ElasticGrant")
+        .def(py::init<>())
+        .def_readwrite("status",  &ElasticGrant::status)
+        .def_readwrite("granted", &ElasticGrant::granted);
+
+    // ResourceDemand
+    py::class_<ResourceDemand>(m, "ResourceDemand")
+        .def(py::init<>())
+        .def_readwrite("resource_type", &ResourceDemand::resource_type)
+        .def_readwrite("quantity",      &ResourceDemand::quantity);
+
     // ResourceRequest
     py::class_<ResourceRequest>(m, "ResourceRequest")
         .def(py::init<>())
@@ -255,7 +345,30 @@ void bind_enums_and_structs(py::module_& m) {
         .def_readwrite("priority",      &ResourceRequest::priority)
         .def_readwrite("timeout",       &ResourceRequest::timeout)
         .def_readwrite("callback",      &ResourceRequest::callback)
-        .def_readwrite("submitted_at",  &ResourceRequest::submitted_at);
+        .def_readwrite("submitted_at",  &ResourceRequest::submitted_at)
+        .def_readwrite("bundle",        &ResourceRequest::bundle)
+        .def("is_bundle",               &ResourceRequest::is_bundle);
+
+    // LatencySummary
+    py::class_<LatencySummary>(m, "LatencySummary")
+        .def(py::init<>())
+        .def_readwrite("count", &LatencySummary::count)
+        .def_readwrite("mean",  &LatencySummary::mean)
+        .def_readwrite("p50",   &LatencySummary::p50)
+        .def_readwrite("p90",   &LatencySummary::p90)
+        .def_readwrite("p99",   &LatencySummary::p99)
+        .def_readwrite("p999",  &LatencySummary::p999)
+        .def_readwrite("max",   &LatencySummary::max);
+
+    // ExecutorStats
+    py::class_<ExecutorStats>(m, "ExecutorStats")
+        .def(py::init<>())
+        .def_readwrite("submitted",     &ExecutorStats::submitted)
+        .def_readwrite("completed",     &ExecutorStats::completed)
+        .def_readwrite("stolen",        &ExecutorStats::stolen)
+        .def_readwrite("queue_depth",   &ExecutorStats::queue_depth)
+        .def_readwrite("queue_wait_us", &ExecutorStats::queue_wait_us)
+        .def_readwrite("run_time_us",   &ExecutorStats::run_time_us);
 
     // MetricsMonitor::Metrics (bound as module-level "Metrics")
     py::class_<MetricsMonitor::Metrics>(m, "Metrics")
@@ -267,7 +380,10 @@ void bind_enums_and_structs(py::module_& m) {
         .def_readwrite("average_wait_time_ms",        &MetricsMonitor::Metrics::average_wait_time_ms)
         .def_readwrite("safety_check_avg_duration_us", &MetricsMonitor::Metrics::safety_check_avg_duration_us)
         .def_readwrite("unsafe_state_detections",     &MetricsMonitor::Metrics::unsafe_state_detections)
-        .def_readwrite("resource_utilization_percent", &MetricsMonitor::Metrics::resource_utilization_percent);
+        .def_readwrite("resource_utilization_percent", &MetricsMonitor::Metrics::resource_utilization_percent)
+        .def_readwrite("wait_time_us",                &MetricsMonitor::Metrics::wait_time_us)
+        .def_readwrite("safety_check_us",             &MetricsMonitor::Metrics::safety_check_us)
+        .def_readwrite("lock_hold_us",                &MetricsMonitor::Metrics::lock_hold_us);
 
     // ---- Priority constants -----------------------------------------------
 
@@ -212,3 +212,12 @@ class TestCompositeMonitor:
                 assert len(rec2.events) > 0
         finally:
             mgr.stop()
+
+    def test_children_fixed_once_installed(self):
+        composite = ag.CompositeMonitor()
+        composite.add_monitor(RecordingMonitor())
+        mgr = ag.ResourceManager()
+        mgr.set_monitor(composite)
+        assert composite.frozen
+        with pytest.raises(RuntimeError):
+            composite.add_monitor(RecordingMonitor())
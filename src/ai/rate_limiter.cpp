@@ -16,6 +16,7 @@ Resource RateLimiter::as_resource() const {
     Resource r(id_, api_name_, ResourceCategory::ApiRateLimit,
                requests_per_window_ + burst_allowance_);
     r.set_replenish_interval(window_to_duration());
+    r.set_replenish_policy(ReplenishPolicy::SlidingWindow);
     return r;
 }
 
@@ -15,6 +15,7 @@ TokenBudget::TokenBudget(ResourceTypeId id,
 Resource TokenBudget::as_resource() const {
     Resource r(id_, name_, ResourceCategory::TokenBudget, total_tokens_);
     r.set_replenish_interval(window_duration_);
+    r.set_replenish_policy(ReplenishPolicy::TokenBucket);
     return r;
 }
 
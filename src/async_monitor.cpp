@@ -0,0 +1,186 @@
+#include "agentguard/async_monitor.hpp"
+
+#include <cstddef>
+
+namespace agentguard {
+
+AsyncMonitor::AsyncMonitor(std::shared_ptr<Monitor> inner, AsyncMonitorConfig config)
+    : inner_(std::move(inner))
+    , config_(config)
+{
+    std::size_t capacity = 2;
+    while (capacity < config_.capacity) capacity <<= 1;
+    cells_ = std::make_unique<Cell[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask_ = capacity - 1;
+    if (config_.sample_every == 0) config_.sample_every = 1;
+
+    dispatcher_ = std::thread([this] { dispatch_loop(); });
+}
+
+AsyncMonitor::~AsyncMonitor() {
+    running_.store(false);
+    {
+        std::lock_guard lock(wake_mutex_);
+    }
+    wake_cv_.notify_one();
+    if (dispatcher_.joinable()) dispatcher_.join();
+}
+
+void AsyncMonitor::on_event(const MonitorEvent& event) {
+    if (!inner_) return;
+
+    bool pushed = false;
+    switch (config_.overflow) {
+        case EventOverflowPolicy::Drop:
+            pushed = try_push(event);
+            break;
+        case EventOverflowPolicy::Sample:
+            if (size() > capacity() / 2 &&
+                sample_counter_.fetch_add(1, std::memory_order_relaxed) % config_.sample_every != 0) {
+                break;
+            }
+            pushed = try_push(event);
+            break;
+        case EventOverflowPolicy::Block:
+            pushed = try_push(event) || push_when_space(event);
+            break;
+    }
+
+    if (!pushed) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    accepted_.fetch_add(1, std::memory_order_release);
+    wake_dispatcher();
+}
+
+void AsyncMonitor::on_snapshot(const SystemSnapshot& snapshot) {
+    if (inner_) inner_->on_snapshot(snapshot);
+}
+
+EventMask AsyncMonitor::subscribed_events() const {
+    return inner_ ? inner_->subscribed_events() : 0;
+}
+
+bool AsyncMonitor::consumes_durations() const {
+    return inner_ && inner_->consumes_durations();
+}
+
+void AsyncMonitor::flush() {
+    std::uint64_t target = accepted_.load(std::memory_order_acquire);
+    std::unique_lock lock(drain_mutex_);
+    flush_waiters_.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in dispatch_loop: either this check sees the
+    // last delivery, or the dispatcher sees us waiting and notifies
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    drained_cv_.wait(lock, [&] {
+        return delivered_.load(std::memory_order_acquire) >= target;
+    });
+    flush_waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::uint64_t AsyncMonitor::dropped_events() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+// Bounded MPMC ring after Vyukov, used here with a single consumer. Each
+// cell's sequence tells producers and the consumer whose turn it is, so
+// neither side takes a lock.
+bool AsyncMonitor::try_push(const MonitorEvent& event) {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[pos & mask_];
+        std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.event = event;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // full
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncMonitor::try_pop(MonitorEvent& out) {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+    out = std::move(cell.event);
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncMonitor::push_when_space(const MonitorEvent& event) {
+    // Sleeps rather than spins: the caller may hold the manager's state lock
+    std::unique_lock lock(space_mutex_);
+    blocked_producers_.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in dispatch_loop: either this retry sees the slot
+    // the dispatcher freed, or the dispatcher sees us blocked and notifies
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!try_push(event)) {
+        wake_dispatcher();
+        space_cv_.wait(lock);
+    }
+    blocked_producers_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::size_t AsyncMonitor::size() const noexcept {
+    return enqueue_pos_.load(std::memory_order_relaxed) -
+           dequeue_pos_.load(std::memory_order_relaxed);
+}
+
+void AsyncMonitor::wake_dispatcher() {
+    // Pairs with the fence in dispatch_loop: either the dispatcher sees the
+    // new event before parking, or we see it parked and notify
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (dispatcher_idle_.load(std::memory_order_relaxed)) {
+        std::lock_guard lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+}
+
+void AsyncMonitor::dispatch_loop() {
+    MonitorEvent event;
+    for (;;) {
+        if (try_pop(event)) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (blocked_producers_.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard lock(space_mutex_);
+                space_cv_.notify_all();
+            }
+            try {
+                inner_->on_event(event);
+            } catch (...) {
+                // A throwing monitor must not take the dispatcher down
+            }
+            delivered_.fetch_add(1, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (flush_waiters_.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard lock(drain_mutex_);
+                drained_cv_.notify_all();
+            }
+            continue;
+        }
+        if (!running_.load()) break;
+
+        // Park until a producer finds us idle and signals the first event
+        std::unique_lock lock(wake_mutex_);
+        dispatcher_idle_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_cv_.wait(lock, [this] { return size() != 0 || !running_.load(); });
+        dispatcher_idle_.store(false, std::memory_order_relaxed);
+    }
+}
+
+} // namespace agentguard
@@ -49,6 +49,8 @@ void DelegationTracker::deregister_agent(AgentId id) {
 void DelegationTracker::set_monitor(std::shared_ptr<Monitor> monitor) {
     std::lock_guard<std::mutex> lock(mutex_);
     monitor_ = std::move(monitor);
+    event_mask_.store(monitor_ ? monitor_->subscribed_events() : 0,
+                      std::memory_order_relaxed);
 }
 
 // ---------------------------------------------------------------------------
@@ -113,22 +115,22 @@ DelegationResult DelegationTracker::report_delegation(
         }
     }
 
-    // Emit events outside lock
-    if (result.accepted) {
+    // Emit events outside lock; messages are only built for subscribers
+    if (result.accepted && wants_event(EventType::DelegationReported)) {
         emit_event(EventType::DelegationReported,
                    "Delegation reported: agent " + std::to_string(from) +
                    " -> agent " + std::to_string(to),
                    from, to);
     }
 
-    if (cycle_found) {
+    if (cycle_found && wants_event(EventType::DelegationCycleDetected)) {
         emit_event(EventType::DelegationCycleDetected,
                    "Delegation cycle detected involving agent " +
                    std::to_string(from) + " -> agent " + std::to_string(to),
                    from, to, result.cycle_path);
     }
 
-    if (cancel_latest) {
+    if (cancel_latest && wants_event(EventType::DelegationCancelled)) {
         emit_event(EventType::DelegationCancelled,
                    "Delegation cancelled (cycle prevention): agent " +
                    std::to_string(from) + " -> agent " + std::to_string(to),
@@ -150,10 +152,12 @@ void DelegationTracker::complete_delegation(AgentId from, AgentId to) {
         edges_.erase({from, to});
     }
 
-    emit_event(EventType::DelegationCompleted,
-               "Delegation completed: agent " + std::to_string(from) +
-               " -> agent " + std::to_string(to),
-               from, to);
+    if (wants_event(EventType::DelegationCompleted)) {
+        emit_event(EventType::DelegationCompleted,
+                   "Delegation completed: agent " + std::to_string(from) +
+                   " -> agent " + std::to_string(to),
+                   from, to);
+    }
 }
 
 void DelegationTracker::cancel_delegation(AgentId from, AgentId to) {
@@ -168,10 +172,12 @@ void DelegationTracker::cancel_delegation(AgentId from, AgentId to) {
         edges_.erase({from, to});
     }
 
-    emit_event(EventType::DelegationCancelled,
-               "Delegation cancelled: agent " + std::to_string(from) +
-               " -> agent " + std::to_string(to),
-               from, to);
+    if (wants_event(EventType::DelegationCancelled)) {
+        emit_event(EventType::DelegationCancelled,
+                   "Delegation cancelled: agent " + std::to_string(from) +
+                   " -> agent " + std::to_string(to),
+                   from, to);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -436,7 +442,7 @@ void DelegationTracker::emit_event(EventType type, const std::string& message,
         mon = monitor_;
     }
 
-    if (!mon) {
+    if (!mon || !wants_event(type)) {
         return;
     }
 
@@ -0,0 +1,140 @@
+#include "agentguard/executor.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace agentguard {
+
+namespace {
+
+constexpr double US_PER_NS = 1e-3;
+
+// Identifies the pool and worker the current thread belongs to, so tasks
+// submitted from a worker stay on its own deque
+thread_local const void* tls_pool = nullptr;
+thread_local std::size_t tls_worker = 0;
+
+std::uint64_t elapsed_ns(Timestamp from, Timestamp to) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+    return ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+}
+
+} // anonymous namespace
+
+ThreadPoolExecutor::ThreadPoolExecutor(std::size_t threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+    stopping_.store(true);
+    {
+        std::lock_guard lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+void ThreadPoolExecutor::start() {
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+    }
+}
+
+void ThreadPoolExecutor::execute(std::function<void()> task) {
+    std::call_once(started_, [this] { start(); });
+
+    std::size_t target = (tls_pool == this)
+        ? tls_worker
+        : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        Worker& worker = *workers_[target];
+        std::lock_guard lock(worker.mutex);
+        worker.jobs.push_back(Job{std::move(task), Clock::now()});
+        pending_.fetch_add(1);
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    // Pairs with the predicate check in worker_loop so the wakeup is not lost
+    {
+        std::lock_guard lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_one();
+}
+
+bool ThreadPoolExecutor::take(std::size_t index, Job& out) {
+    // Own deque first, oldest task first
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.jobs.empty()) {
+            out = std::move(own.jobs.front());
+            own.jobs.pop_front();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    // Then steal the newest task of another worker
+    for (std::size_t i = 1; i < workers_.size(); ++i) {
+        Worker& victim = *workers_[(index + i) % workers_.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            out = std::move(victim.jobs.back());
+            victim.jobs.pop_back();
+            pending_.fetch_sub(1);
+            stolen_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPoolExecutor::run(Job& job) {
+    auto started = Clock::now();
+    queue_wait_ns_.record(elapsed_ns(job.enqueued, started));
+    try {
+        job.fn();
+    } catch (...) {
+        // A throwing callback must not take the worker down
+    }
+    run_time_ns_.record(elapsed_ns(started, Clock::now()));
+    job.fn = nullptr;
+    completed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ThreadPoolExecutor::worker_loop(std::size_t index) {
+    tls_pool = this;
+    tls_worker = index;
+
+    Job job;
+    for (;;) {
+        if (take(index, job)) {
+            run(job);
+            continue;
+        }
+        std::unique_lock lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] { return pending_.load() > 0 || stopping_.load(); });
+        // Drain everything queued before exiting
+        if (pending_.load() == 0 && stopping_.load()) break;
+    }
+
+    tls_pool = nullptr;
+}
+
+ExecutorStats ThreadPoolExecutor::stats() const {
+    ExecutorStats s;
+    s.submitted = submitted_.load(std::memory_order_relaxed);
+    s.completed = completed_.load(std::memory_order_relaxed);
+    s.stolen = stolen_.load(std::memory_order_relaxed);
+    s.queue_depth = pending_.load();
+    s.queue_wait_us = queue_wait_ns_.summary(US_PER_NS);
+    s.run_time_us = run_time_ns_.summary(US_PER_NS);
+    return s;
+}
+
+} // namespace agentguard
@@ -0,0 +1,98 @@
+#include "agentguard/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace agentguard {
+
+namespace {
+
+unsigned floor_log2(std::uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+    unsigned e = 0;
+    while (v >>= 1) ++e;
+    return e;
+#endif
+}
+
+} // anonymous namespace
+
+std::size_t LatencyHistogram::bucket_index(std::uint64_t value) noexcept {
+    value = std::min(value, MAX_VALUE);
+    if (value < SUB_BUCKETS) return static_cast<std::size_t>(value);
+
+    unsigned shift = floor_log2(value) - SUB_BUCKET_BITS;
+    std::uint64_t mantissa = value >> shift;  // in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    return static_cast<std::size_t>((shift + 1) * SUB_BUCKETS + (mantissa - SUB_BUCKETS));
+}
+
+std::uint64_t LatencyHistogram::bucket_value(std::size_t index) noexcept {
+    if (index < SUB_BUCKETS) return index;
+
+    unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+    std::uint64_t mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+    std::uint64_t width = std::uint64_t{1} << shift;
+    return (mantissa << shift) + (width - 1) / 2;
+}
+
+void LatencyHistogram::record(std::uint64_t value) noexcept {
+    buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (value > seen &&
+           !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t LatencyHistogram::count() const noexcept {
+    return count_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const noexcept {
+    // Sum the buckets rather than trusting count_, which concurrent
+    // recorders may have bumped ahead of their bucket
+    std::uint64_t total = 0;
+    for (auto& b : buckets_) total += b.load(std::memory_order_relaxed);
+    if (total == 0) return 0;
+
+    p = std::clamp(p, 0.0, 100.0);
+    auto rank = static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total)));
+    rank = std::max<std::uint64_t>(rank, 1);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucket_value(i), max_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_.load(std::memory_order_relaxed);
+}
+
+LatencySummary LatencyHistogram::summary(double scale) const noexcept {
+    LatencySummary s;
+    s.count = count();
+    if (s.count == 0) return s;
+
+    s.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+             static_cast<double>(s.count) * scale;
+    s.p50 = static_cast<double>(percentile(50.0)) * scale;
+    s.p90 = static_cast<double>(percentile(90.0)) * scale;
+    s.p99 = static_cast<double>(percentile(99.0)) * scale;
+    s.p999 = static_cast<double>(percentile(99.9)) * scale;
+    s.max = static_cast<double>(max_.load(std::memory_order_relaxed)) * scale;
+    return s;
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace agentguard
@@ -1,8 +1,11 @@
 #include "agentguard/monitor.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 namespace agentguard {
 
@@ -34,27 +37,42 @@ const char* to_string(EventType t) {
         case EventType::DemandEstimateUpdated:    return "DemandEstimateUpdated";
         case EventType::ProbabilisticSafetyCheck: return "ProbabilisticSafetyCheck";
         case EventType::AdaptiveDemandModeChanged:return "AdaptiveDemandModeChanged";
+        case EventType::LockHeld:                 return "LockHeld";
+        case EventType::RequestStarved:           return "RequestStarved";
+        case EventType::ResourcesConsumed:        return "ResourcesConsumed";
+        case EventType::ResourcesReplenished:     return "ResourcesReplenished";
     }
     return "Unknown";
 }
 
-bool is_important_event(EventType t) {
-    switch (t) {
-        case EventType::RequestGranted:
-        case EventType::RequestDenied:
-        case EventType::RequestTimedOut:
-        case EventType::UnsafeStateDetected:
-        case EventType::AgentRegistered:
-        case EventType::AgentDeregistered:
-        case EventType::AgentStalled:
-        case EventType::AgentStallResolved:
-        case EventType::AgentResourcesAutoReleased:
-        case EventType::DelegationCycleDetected:
-            return true;
-        default:
-            return false;
-    }
-}
+// What ConsoleMonitor prints at Normal verbosity
+constexpr EventMask IMPORTANT_EVENTS = event_mask({
+    EventType::RequestGranted,
+    EventType::RequestDenied,
+    EventType::RequestTimedOut,
+    EventType::RequestStarved,
+    EventType::UnsafeStateDetected,
+    EventType::AgentRegistered,
+    EventType::AgentDeregistered,
+    EventType::AgentStalled,
+    EventType::AgentStallResolved,
+    EventType::AgentResourcesAutoReleased,
+    EventType::DelegationCycleDetected,
+});
+
+// What MetricsMonitor::on_event looks at
+constexpr EventMask METRICS_EVENTS = event_mask({
+    EventType::RequestSubmitted,
+    EventType::RequestGranted,
+    EventType::RequestDenied,
+    EventType::RequestTimedOut,
+    EventType::SafetyCheckPerformed,
+    EventType::ProbabilisticSafetyCheck,
+    EventType::UnsafeStateDetected,
+    EventType::LockHeld,
+});
+
+constexpr double US_PER_NS = 1e-3;
 
 } // anonymous namespace
 
@@ -63,8 +81,7 @@ bool is_important_event(EventType t) {
 ConsoleMonitor::ConsoleMonitor(Verbosity v) : verbosity_(v) {}
 
 void ConsoleMonitor::on_event(const MonitorEvent& event) {
-    if (verbosity_ == Verbosity::Quiet) return;
-    if (verbosity_ == Verbosity::Normal && !is_important_event(event.type)) return;
+    if (!(subscribed_events() & event_bit(event.type))) return;
 
     std::lock_guard<std::mutex> lock(output_mutex_);
 
@@ -96,6 +113,14 @@ void ConsoleMonitor::on_event(const MonitorEvent& event) {
     std::cout << "\n";
 }
 
+EventMask ConsoleMonitor::subscribed_events() const {
+    switch (verbosity_) {
+        case Verbosity::Quiet:  return 0;
+        case Verbosity::Normal: return IMPORTANT_EVENTS;
+        default:                return ALL_EVENTS;
+    }
+}
+
 void ConsoleMonitor::on_snapshot(const SystemSnapshot& snapshot) {
     if (verbosity_ < Verbosity::Verbose) return;
 
@@ -123,7 +148,49 @@ void ConsoleMonitor::on_snapshot(const SystemSnapshot& snapshot) {
 
 MetricsMonitor::MetricsMonitor() = default;
 
+void MetricsMonitor::record_latency(LatencyMetric metric, const MonitorEvent& event) {
+    double ns = std::max(0.0, *event.duration_us * 1000.0);
+    auto value = static_cast<std::uint64_t>(std::llround(ns));
+    LatencySet& set = latency_[static_cast<std::size_t>(metric)];
+
+    set.overall.record(value);
+    if (event.priority) {
+        set.by_priority[static_cast<std::size_t>(priority_class(*event.priority))].record(value);
+    }
+    if (event.resource_type) {
+        {
+            std::shared_lock lock(latency_mutex_);
+            auto it = set.by_resource.find(*event.resource_type);
+            if (it != set.by_resource.end()) {
+                it->second->record(value);
+                return;
+            }
+        }
+        std::unique_lock lock(latency_mutex_);
+        auto& hist = set.by_resource[*event.resource_type];
+        if (!hist) hist = std::make_unique<LatencyHistogram>();
+        hist->record(value);
+    }
+}
+
 void MetricsMonitor::on_event(const MonitorEvent& event) {
+    if (event.duration_us.has_value()) {
+        switch (event.type) {
+            case EventType::RequestGranted:
+                record_latency(LatencyMetric::Wait, event);
+                break;
+            case EventType::SafetyCheckPerformed:
+            case EventType::ProbabilisticSafetyCheck:
+                record_latency(LatencyMetric::SafetyCheck, event);
+                break;
+            case EventType::LockHeld:
+                record_latency(LatencyMetric::LockHold, event);
+                return;  // nothing else to count
+            default:
+                break;
+        }
+    }
+
     std::lock_guard<std::mutex> lock(metrics_mutex_);
 
     switch (event.type) {
@@ -136,8 +203,17 @@ void MetricsMonitor::on_event(const MonitorEvent& event) {
             break;
         case EventType::RequestGranted:
             metrics_.granted_requests++;
-            // Calculate wait time from submit to grant
-            if (event.request_id.has_value()) {
+            // Wait time from submit to grant: carried on the event when the
+            // manager measured it, else matched against the submit event
+            if (event.duration_us.has_value()) {
+                wait_time_sum_ms_ += *event.duration_us / 1000.0;
+                wait_time_sample_count_++;
+                metrics_.average_wait_time_ms =
+                    wait_time_sum_ms_ / static_cast<double>(wait_time_sample_count_);
+                if (event.request_id.has_value()) {
+                    pending_submit_times_.erase(*event.request_id);
+                }
+            } else if (event.request_id.has_value()) {
                 auto it = pending_submit_times_.find(*event.request_id);
                 if (it != pending_submit_times_.end()) {
                     double ms = std::chrono::duration<double, std::milli>(
@@ -209,9 +285,38 @@ void MetricsMonitor::on_snapshot(const SystemSnapshot& snapshot) {
     }
 }
 
+EventMask MetricsMonitor::subscribed_events() const {
+    return METRICS_EVENTS;
+}
+
 MetricsMonitor::Metrics MetricsMonitor::get_metrics() const {
-    std::lock_guard<std::mutex> lock(metrics_mutex_);
-    return metrics_;
+    Metrics m;
+    {
+        std::lock_guard<std::mutex> lock(metrics_mutex_);
+        m = metrics_;
+    }
+    m.wait_time_us = latency(LatencyMetric::Wait);
+    m.safety_check_us = latency(LatencyMetric::SafetyCheck);
+    m.lock_hold_us = latency(LatencyMetric::LockHold);
+    return m;
+}
+
+LatencySummary MetricsMonitor::latency(LatencyMetric metric) const {
+    return latency_[static_cast<std::size_t>(metric)].overall.summary(US_PER_NS);
+}
+
+LatencySummary MetricsMonitor::latency_for_resource(LatencyMetric metric,
+                                                    ResourceTypeId rt) const {
+    const LatencySet& set = latency_[static_cast<std::size_t>(metric)];
+    std::shared_lock lock(latency_mutex_);
+    auto it = set.by_resource.find(rt);
+    return it != set.by_resource.end() ? it->second->summary(US_PER_NS) : LatencySummary{};
+}
+
+LatencySummary MetricsMonitor::latency_for_priority(LatencyMetric metric,
+                                                    PriorityClass pc) const {
+    const LatencySet& set = latency_[static_cast<std::size_t>(metric)];
+    return set.by_priority[static_cast<std::size_t>(pc)].summary(US_PER_NS);
 }
 
 void MetricsMonitor::reset_metrics() {
@@ -222,6 +327,13 @@ void MetricsMonitor::reset_metrics() {
     wait_time_sum_ms_ = 0.0;
     safety_check_count_ = 0;
     safety_check_duration_sum_us_ = 0.0;
+
+    std::unique_lock latency_lock(latency_mutex_);
+    for (auto& set : latency_) {
+        set.overall.reset();
+        for (auto& h : set.by_priority) h.reset();
+        set.by_resource.clear();
+    }
 }
 
 void MetricsMonitor::set_utilization_alert_threshold(double threshold, AlertCallback cb) {
@@ -239,12 +351,24 @@ void MetricsMonitor::set_queue_size_alert_threshold(std::size_t threshold, Alert
 // ========== CompositeMonitor ==========
 
 void CompositeMonitor::add_monitor(std::shared_ptr<Monitor> monitor) {
+    if (frozen_.load()) {
+        throw std::logic_error("CompositeMonitor: children must be added before it is installed");
+    }
+    masks_.push_back(monitor->subscribed_events());
     monitors_.push_back(std::move(monitor));
 }
 
-void CompositeMonitor::on_event(const MonitorEvent& event) {
+void CompositeMonitor::freeze() {
+    frozen_.store(true);
     for (auto& m : monitors_) {
-        m->on_event(event);
+        if (auto nested = std::dynamic_pointer_cast<CompositeMonitor>(m)) nested->freeze();
+    }
+}
+
+void CompositeMonitor::on_event(const MonitorEvent& event) {
+    const EventMask bit = event_bit(event.type);
+    for (std::size_t i = 0; i < monitors_.size(); ++i) {
+        if (masks_[i] & bit) monitors_[i]->on_event(event);
     }
 }
 
@@ -254,4 +378,17 @@ void CompositeMonitor::on_snapshot(const SystemSnapshot& snapshot) {
     }
 }
 
+EventMask CompositeMonitor::subscribed_events() const {
+    EventMask mask = 0;
+    for (EventMask m : masks_) mask |= m;
+    return mask;
+}
+
+bool CompositeMonitor::consumes_durations() const {
+    for (auto& m : monitors_) {
+        if (m->consumes_durations()) return true;
+    }
+    return false;
+}
+
 } // namespace agentguard
@@ -44,11 +44,13 @@ void ProgressTracker::report_progress(AgentId id, const std::string& metric_name
     }
 
     // Outside the lock: emit events
-    emit_event(EventType::AgentProgressReported,
-               "Agent " + std::to_string(id) + " reported progress: " + metric_name + " = " + std::to_string(value),
-               id);
+    if (wants_event(EventType::AgentProgressReported)) {
+        emit_event(EventType::AgentProgressReported,
+                   "Agent " + std::to_string(id) + " reported progress: " + metric_name + " = " + std::to_string(value),
+                   id);
+    }
 
-    if (was_stalled) {
+    if (was_stalled && wants_event(EventType::AgentStallResolved)) {
         emit_event(EventType::AgentStallResolved,
                    "Agent " + std::to_string(id) + " stall resolved after progress report",
                    id);
@@ -94,6 +96,8 @@ std::optional<ProgressRecord> ProgressTracker::get_progress(AgentId id) const {
 
 void ProgressTracker::start(std::shared_ptr<Monitor> monitor, StallActionCallback stall_action) {
     monitor_ = std::move(monitor);
+    event_mask_.store(monitor_ ? monitor_->subscribed_events() : 0,
+                      std::memory_order_relaxed);
     stall_action_ = std::move(stall_action);
     running_.store(true);
     checker_thread_ = std::thread(&ProgressTracker::check_loop, this);
@@ -142,9 +146,11 @@ void ProgressTracker::check_for_stalls() {
 
     // Outside the lock: emit events and invoke stall actions
     for (AgentId id : newly_stalled) {
-        emit_event(EventType::AgentStalled,
-                   "Agent " + std::to_string(id) + " has stalled (no progress reported)",
-                   id);
+        if (wants_event(EventType::AgentStalled)) {
+            emit_event(EventType::AgentStalled,
+                       "Agent " + std::to_string(id) + " has stalled (no progress reported)",
+                       id);
+        }
 
         if (config_.auto_release_on_stall && stall_action_) {
             stall_action_(id);
@@ -153,15 +159,15 @@ void ProgressTracker::check_for_stalls() {
 }
 
 void ProgressTracker::emit_event(EventType type, const std::string& message, AgentId agent_id) {
+    if (!monitor_ || !wants_event(type)) return;
+
     MonitorEvent event;
     event.type = type;
     event.timestamp = Clock::now();
     event.message = message;
     event.agent_id = agent_id;
 
-    if (monitor_) {
-        monitor_->on_event(event);
-    }
+    monitor_->on_event(event);
 }
 
 } // namespace agentguard
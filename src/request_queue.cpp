@@ -2,6 +2,8 @@
 #include "agentguard/exceptions.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 
 namespace agentguard {
 
@@ -9,17 +11,53 @@ RequestQueue::RequestQueue(std::size_t max_queue_size)
     : max_queue_size_(max_queue_size)
 {}
 
+void RequestQueue::set_executor(std::shared_ptr<Executor> executor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    executor_ = std::move(executor);
+}
+
+void RequestQueue::complete(std::vector<Completion>& done,
+                            const std::shared_ptr<Executor>& executor) {
+    for (auto& c : done) {
+        if (executor) {
+            executor->execute([cb = std::move(c.callback), id = c.id, status = c.status] {
+                cb(id, status);
+            });
+        } else {
+            c.callback(c.id, c.status);
+        }
+    }
+}
+
 RequestId RequestQueue::enqueue(ResourceRequest request) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (requests_.size() >= max_queue_size_) {
         throw QueueFullException();
     }
+    if (request.is_bundle()) {
+        // Merge repeated resources so each part is indexed once
+        std::vector<ResourceDemand> merged;
+        for (auto& part : request.bundle) {
+            auto same = std::find_if(merged.begin(), merged.end(), [&](const ResourceDemand& d) {
+                return d.resource_type == part.resource_type;
+            });
+            if (same != merged.end()) {
+                same->quantity += part.quantity;
+            } else {
+                merged.push_back(part);
+            }
+        }
+        request.bundle = std::move(merged);
+        request.resource_type = request.bundle.front().resource_type;
+        request.quantity = request.bundle.front().quantity;
+    }
     request.id = next_request_id_++;
     request.submitted_at = Clock::now();
-    requests_.push_back(std::move(request));
-    sort_requests();
+    RequestId id = request.id;
+    unreported_.emplace(request.submitted_at, id);
+    insert(std::move(request));
     cv_.notify_one();
-    return next_request_id_ - 1;
+    return id;
 }
 
 std::optional<ResourceRequest> RequestQueue::dequeue() {
@@ -27,9 +65,7 @@ std::optional<ResourceRequest> RequestQueue::dequeue() {
     if (requests_.empty()) {
         return std::nullopt;
     }
-    auto req = std::move(requests_.front());
-    requests_.erase(requests_.begin());
-    return req;
+    return pop_front();
 }
 
 std::optional<ResourceRequest> RequestQueue::peek() const {
@@ -37,81 +73,191 @@ std::optional<ResourceRequest> RequestQueue::peek() const {
     if (requests_.empty()) {
         return std::nullopt;
     }
-    return requests_.front();
+    return requests_.begin()->second;
 }
 
 bool RequestQueue::cancel(RequestId id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = std::find_if(requests_.begin(), requests_.end(),
-        [id](const ResourceRequest& r) { return r.id == id; });
-    if (it != requests_.end()) {
-        if (it->callback) {
-            it->callback(it->id, RequestStatus::Cancelled);
+    std::vector<Completion> done;
+    std::shared_ptr<Executor> executor;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = by_id_.find(id);
+        if (found == by_id_.end()) {
+            return false;
         }
-        requests_.erase(it);
-        return true;
+        auto it = found->second;
+        if (it->second.callback) {
+            done.push_back({std::move(it->second.callback), id, RequestStatus::Cancelled});
+        }
+        erase(it);
+        executor = executor_;
     }
-    return false;
+    complete(done, executor);
+    return true;
 }
 
-std::size_t RequestQueue::cancel_all_for_agent(AgentId agent_id) {
+bool RequestQueue::remove(RequestId id) {
     std::lock_guard<std::mutex> lock(mutex_);
-    std::size_t count = 0;
-    auto it = requests_.begin();
-    while (it != requests_.end()) {
-        if (it->agent_id == agent_id) {
-            if (it->callback) {
-                it->callback(it->id, RequestStatus::Cancelled);
+    auto found = by_id_.find(id);
+    if (found == by_id_.end()) {
+        return false;
+    }
+    erase(found->second);
+    return true;
+}
+
+std::optional<ResourceRequest> RequestQueue::find(RequestId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = by_id_.find(id);
+    if (found == by_id_.end()) {
+        return std::nullopt;
+    }
+    return found->second->second;
+}
+
+std::size_t RequestQueue::cancel_all_for_agent(AgentId agent_id) {
+    std::vector<Completion> done;
+    std::shared_ptr<Executor> executor;
+    std::size_t removed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto index = by_agent_.find(agent_id);
+        if (index == by_agent_.end()) {
+            return 0;
+        }
+
+        // erase() updates the index, so walk a copy of the keys
+        std::vector<OrderKey> keys(index->second.begin(), index->second.end());
+        for (auto& key : keys) {
+            auto it = by_id_.at(key.id);
+            if (it->second.callback) {
+                done.push_back({std::move(it->second.callback), key.id, RequestStatus::Cancelled});
             }
-            it = requests_.erase(it);
-            ++count;
-        } else {
-            ++it;
+            erase(it);
         }
+        removed = keys.size();
+        executor = executor_;
     }
-    return count;
+    complete(done, executor);
+    return removed;
+}
+
+std::size_t RequestQueue::cancel_all() {
+    std::vector<Completion> done;
+    std::shared_ptr<Executor> executor;
+    std::size_t removed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [key, req] : requests_) {
+            if (req.callback) {
+                done.push_back({std::move(req.callback), key.id, RequestStatus::Cancelled});
+            }
+        }
+        removed = requests_.size();
+        requests_.clear();
+        by_id_.clear();
+        by_resource_.clear();
+        by_agent_.clear();
+        deadlines_.clear();
+        unreported_.clear();
+        executor = executor_;
+    }
+    complete(done, executor);
+    return removed;
 }
 
 std::vector<ResourceRequest> RequestQueue::get_all_pending() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return requests_;
+    std::vector<ResourceRequest> result;
+    result.reserve(requests_.size());
+    for (auto& [key, req] : requests_) {
+        result.push_back(req);
+    }
+    return result;
 }
 
 std::vector<ResourceRequest> RequestQueue::get_pending_for_resource(ResourceTypeId rt) const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<ResourceRequest> result;
-    for (auto& req : requests_) {
-        if (req.resource_type == rt) {
-            result.push_back(req);
-        }
+    auto index = by_resource_.find(rt);
+    if (index == by_resource_.end()) {
+        return result;
+    }
+    result.reserve(index->second.size());
+    for (auto& key : index->second) {
+        result.push_back(by_id_.at(key.id)->second);
     }
     return result;
 }
 
 std::vector<RequestId> RequestQueue::expire_timed_out() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto now = Clock::now();
     std::vector<RequestId> expired;
-
-    auto it = requests_.begin();
-    while (it != requests_.end()) {
-        if (it->timeout.has_value()) {
-            auto deadline = it->submitted_at + it->timeout.value();
-            if (now >= deadline) {
-                expired.push_back(it->id);
-                if (it->callback) {
-                    it->callback(it->id, RequestStatus::TimedOut);
-                }
-                it = requests_.erase(it);
-                continue;
+    std::vector<Completion> done;
+    std::shared_ptr<Executor> executor;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        while (!deadlines_.empty() && deadlines_.begin()->first <= now) {
+            RequestId id = deadlines_.begin()->second;
+            auto it = by_id_.at(id);
+            expired.push_back(id);
+            if (it->second.callback) {
+                done.push_back({std::move(it->second.callback), id, RequestStatus::TimedOut});
             }
+            erase(it);
         }
-        ++it;
+        executor = executor_;
     }
-
+    complete(done, executor);
     return expired;
 }
 
+std::optional<Timestamp> RequestQueue::next_deadline() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deadlines_.empty()) {
+        return std::nullopt;
+    }
+    return deadlines_.begin()->first;
+}
+
+std::vector<ResourceRequest> RequestQueue::take_starved(Timestamp cutoff) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ResourceRequest> starved;
+    while (!unreported_.empty() && unreported_.begin()->first <= cutoff) {
+        starved.push_back(by_id_.at(unreported_.begin()->second)->second);
+        unreported_.erase(unreported_.begin());
+    }
+    return starved;
+}
+
+std::optional<Timestamp> RequestQueue::oldest_unreported() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (unreported_.empty()) {
+        return std::nullopt;
+    }
+    return unreported_.begin()->first;
+}
+
+std::optional<Priority> RequestQueue::boost_priority(RequestId id, Priority delta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = by_id_.find(id);
+    if (found == by_id_.end()) {
+        return std::nullopt;
+    }
+
+    ResourceRequest request = found->second->second;
+    bool watched = unreported_.count({request.submitted_at, id}) > 0;
+    erase(found->second);
+
+    auto raised = static_cast<std::int64_t>(request.priority) + delta;
+    request.priority = static_cast<Priority>(std::clamp<std::int64_t>(
+        raised, std::numeric_limits<Priority>::min(), std::numeric_limits<Priority>::max()));
+    if (watched) unreported_.emplace(request.submitted_at, id);
+    Priority boosted = request.priority;
+    insert(std::move(request));
+    return boosted;
+}
+
 std::size_t RequestQueue::size() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return requests_.size();
@@ -136,26 +282,60 @@ std::optional<ResourceRequest> RequestQueue::wait_and_dequeue(Duration timeout)
     if (!cv_.wait_for(lock, timeout, [this] { return !requests_.empty(); })) {
         return std::nullopt;
     }
-    auto req = std::move(requests_.front());
-    requests_.erase(requests_.begin());
-    return req;
+    return pop_front();
 }
 
 void RequestQueue::notify() {
     cv_.notify_all();
 }
 
-bool RequestQueue::compare(const ResourceRequest& a, const ResourceRequest& b) {
-    // Higher priority first
-    if (a.priority != b.priority) {
-        return a.priority > b.priority;
+void RequestQueue::insert(ResourceRequest request) {
+    RequestId id = request.id;
+    OrderKey key{request.priority, request.submitted_at, id};
+    if (request.timeout.has_value()) {
+        deadlines_.emplace(request.submitted_at + request.timeout.value(), id);
     }
-    // Earlier submission first (FIFO within same priority)
-    return a.submitted_at < b.submitted_at;
+    if (request.is_bundle()) {
+        for (auto& part : request.bundle) by_resource_[part.resource_type].insert(key);
+    } else {
+        by_resource_[request.resource_type].insert(key);
+    }
+    by_agent_[request.agent_id].insert(key);
+    auto it = requests_.emplace(key, std::move(request)).first;
+    by_id_.emplace(id, it);
+}
+
+RequestQueue::OrderedRequests::iterator RequestQueue::erase(OrderedRequests::iterator it) {
+    unindex(it);
+    return requests_.erase(it);
 }
 
-void RequestQueue::sort_requests() {
-    std::stable_sort(requests_.begin(), requests_.end(), compare);
+void RequestQueue::unindex(OrderedRequests::const_iterator it) {
+    auto drop = [&](auto& index, auto owner) {
+        auto found = index.find(owner);
+        found->second.erase(it->first);
+        if (found->second.empty()) index.erase(found);
+    };
+    if (it->second.is_bundle()) {
+        for (auto& part : it->second.bundle) drop(by_resource_, part.resource_type);
+    } else {
+        drop(by_resource_, it->second.resource_type);
+    }
+    drop(by_agent_, it->second.agent_id);
+    if (it->second.timeout.has_value()) {
+        deadlines_.erase({it->second.submitted_at + it->second.timeout.value(), it->first.id});
+    }
+    unreported_.erase({it->second.submitted_at, it->first.id});
+    by_id_.erase(it->first.id);
+}
+
+ResourceRequest RequestQueue::pop_front() {
+    // Unindex before moving out: a moved-from request has lost its bundle
+    auto it = requests_.begin();
+    unindex(it);
+    auto req = std::move(it->second);
+    requests_.erase(it);
+    return req;
 }
 
 } // namespace agentguard
@@ -23,10 +23,13 @@ const std::string& Resource::name() const noexcept { return name_; }
 ResourceCategory Resource::category() const noexcept { return category_; }
 ResourceQuantity Resource::total_capacity() const noexcept { return total_capacity_; }
 ResourceQuantity Resource::allocated() const noexcept { return allocated_; }
-ResourceQuantity Resource::available() const noexcept { return total_capacity_ - allocated_; }
+ResourceQuantity Resource::consumed() const noexcept { return consumed_; }
+ResourceQuantity Resource::available() const noexcept {
+    return total_capacity_ - allocated_ - consumed_;
+}
 
 bool Resource::set_total_capacity(ResourceQuantity new_capacity) {
-    if (new_capacity < allocated_) {
+    if (new_capacity < allocated_ + consumed_) {
         return false;
     }
     total_capacity_ = new_capacity;
@@ -41,6 +44,14 @@ std::optional<Duration> Resource::replenish_interval() const noexcept {
     return replenish_interval_;
 }
 
+void Resource::set_replenish_policy(ReplenishPolicy policy) {
+    replenish_policy_ = policy;
+}
+
+ReplenishPolicy Resource::replenish_policy() const noexcept {
+    return replenish_policy_;
+}
+
 void Resource::set_cost_per_unit(double cost) {
     cost_per_unit_ = cost;
 }
@@ -60,4 +71,16 @@ void Resource::deallocate(ResourceQuantity qty) {
     }
 }
 
+void Resource::consume(ResourceQuantity qty) {
+    allocated_ -= qty;
+    consumed_ += qty;
+}
+
+void Resource::replenish(ResourceQuantity qty) {
+    consumed_ -= qty;
+    if (consumed_ < 0) {
+        consumed_ = 0;
+    }
+}
+
 } // namespace agentguard
@@ -1,15 +1,368 @@
 #include "agentguard/resource_manager.hpp"
+#include "agentguard/async_monitor.hpp"
 #include "agentguard/exceptions.hpp"
 
 #include <algorithm>
+#include <chrono>
 
 namespace agentguard {
 
+namespace {
+
+// What the safety check counts as available. Consumed units come back as
+// their resource replenishes, whatever agents do, so waiting for them can
+// delay an agent but never deadlock it.
+ResourceQuantity safety_available(const Resource& res) {
+    return res.available() + res.consumed();
+}
+
+} // anonymous namespace
+
+// ==================== Span Timing ====================
+
+// Times a span only when a monitor will read the duration
+class ResourceManager::SpanTimer {
+public:
+    explicit SpanTimer(bool enabled) : enabled_(enabled) {
+        if (enabled_) start_ = std::chrono::steady_clock::now();
+    }
+
+    std::optional<double> elapsed_us() const {
+        if (!enabled_) return std::nullopt;
+        return std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    bool enabled_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// ==================== Waiter Slots ====================
+
+struct ResourceManager::WaitSlot {
+    std::condition_variable_any cv;
+    AgentId agent_id{0};
+    std::vector<std::pair<ResourceTypeId, ResourceQuantity>> wants;
+    Timestamp since{};
+    bool signalled{false};
+    bool starved{false};  // already reported
+
+    void signal() {
+        if (signalled) return;
+        signalled = true;
+        cv.notify_one();
+    }
+};
+
+// Holds state_mutex_ exclusively and keeps the calling thread registered as
+// a waiter until unlock() or scope exit. Events raised meanwhile are
+// deferred and delivered whenever the lock is dropped.
+class ResourceManager::WaiterScope {
+public:
+    WaiterScope(ResourceManager& rm, AgentId agent_id,
+                std::vector<std::pair<ResourceTypeId, ResourceQuantity>> wants)
+        : rm_(rm), lock_(rm.state_mutex_)
+    {
+        slot_.agent_id = agent_id;
+        slot_.since = Clock::now();
+        slot_.wants = std::move(wants);
+        for (auto& [rt, qty] : slot_.wants) rm_.waiters_[rt].push_back(&slot_);
+    }
+
+    ~WaiterScope() {
+        if (lock_.owns_lock()) {
+            leave();
+            lock_.unlock();
+        }
+        flush();
+    }
+
+    WaiterScope(const WaiterScope&) = delete;
+    WaiterScope& operator=(const WaiterScope&) = delete;
+
+    // Waiters whose last attempt fit but was refused as unsafe can be
+    // unblocked by a release of any resource.
+    void set_unsafe(bool unsafe) {
+        if (unsafe) rm_.unsafe_waiters_.insert(&slot_);
+        else rm_.unsafe_waiters_.erase(&slot_);
+    }
+
+    // Sleeps until signalled, the deadline, or the moment the caller is due
+    // to be reported as starved. Every change that can unblock a caller
+    // signals its slot (wake_waiters, wake_all_waiters), so nothing polls.
+    // Returns false without sleeping once the deadline has passed.
+    bool wait(Timestamp deadline) {
+        if (Clock::now() >= deadline) return false;
+        Timestamp until = deadline;
+        if (auto report = starvation_due()) until = std::min(until, *report);
+        // Signals that arrive while deferred events go out are kept
+        slot_.signalled = false;
+        deliver_deferred();
+        slot_.cv.wait_until(lock_, until, [this] { return slot_.signalled; });
+        rm_.waiter_wakeups_.fetch_add(1, std::memory_order_relaxed);
+        report_if_starved();
+        return true;
+    }
+
+    void unlock() {
+        leave();
+        lock_.unlock();
+        flush();
+    }
+
+    void defer(std::optional<MonitorEvent> event) {
+        if (event) deferred_.push_back(std::move(*event));
+    }
+
+private:
+    std::optional<Timestamp> starvation_due() const {
+        const Duration threshold = rm_.config_.starvation_threshold;
+        if (slot_.starved || threshold <= Duration::zero()) return std::nullopt;
+        if (!rm_.wants_event(EventType::RequestStarved)) return std::nullopt;
+        return slot_.since + threshold;
+    }
+
+    // Blocked callers are not in the request queue, so each checks its own
+    // age whenever it wakes, and wait() wakes when it comes due. The report is
+    // made with the state lock dropped; the caller re-reads the state after
+    // wait() anyway, and a signal in the meantime is seen by that re-check.
+    void report_if_starved() {
+        auto due = starvation_due();
+        if (!due) return;
+        auto now = Clock::now();
+        if (now < *due) return;
+        auto age = now - slot_.since;
+        slot_.starved = true;
+        double age_us = std::chrono::duration<double, std::micro>(age).count();
+        for (auto& [rt, qty] : slot_.wants) {
+            defer(rm_.make_event(EventType::RequestStarved,
+                                 "Blocked request exceeded starvation threshold",
+                                 slot_.agent_id, rt, std::nullopt, qty, std::nullopt, age_us));
+        }
+        deliver_deferred();
+    }
+
+    // Delivers deferred events with the lock dropped for the duration
+    void deliver_deferred() {
+        if (deferred_.empty()) return;
+        lock_.unlock();
+        flush();
+        lock_.lock();
+    }
+
+    void flush() {
+        auto events = std::move(deferred_);
+        deferred_.clear();
+        for (auto& event : events) rm_.emit_event(event);
+    }
+
+    void leave() {
+        for (auto& [rt, qty] : slot_.wants) {
+            auto it = rm_.waiters_.find(rt);
+            if (it == rm_.waiters_.end()) continue;
+            auto& list = it->second;
+            list.erase(std::find(list.begin(), list.end(), &slot_));
+            if (list.empty()) rm_.waiters_.erase(it);
+        }
+        rm_.unsafe_waiters_.erase(&slot_);
+    }
+
+    ResourceManager& rm_;
+    std::unique_lock<std::shared_mutex> lock_;
+    WaitSlot slot_;
+    std::vector<MonitorEvent> deferred_;
+};
+
+// ==================== Published State ====================
+
+// One change to the read model, made while holding state_mutex_
+// exclusively. publish_seq_ stays odd for its lifetime, so readers that
+// span several cells retry rather than mix two states.
+class ResourceManager::PublishScope {
+public:
+    explicit PublishScope(ResourceManager& rm) : rm_(rm) {
+        rm_.publish_seq_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    ~PublishScope() {
+        rm_.publish_seq_.fetch_add(1, std::memory_order_release);
+    }
+
+    PublishScope(const PublishScope&) = delete;
+    PublishScope& operator=(const PublishScope&) = delete;
+
+    void agent(const Agent& agent) {
+        auto& cells = index().agents;
+        auto it = cells.find(agent.id());
+        if (it != cells.end()) store(*it->second, agent);
+    }
+
+    void resource(const Resource& res) {
+        auto& cells = index().resources;
+        auto it = cells.find(res.id());
+        if (it != cells.end()) store(*it->second, res);
+    }
+
+    // Agents or resources came or went. Cells of those that stayed carry
+    // over; only new ones are copied.
+    void entities() {
+        const auto& old = index();
+        auto fresh = std::make_shared<PublishedIndex>();
+        for (auto& [id, res] : rm_.resources_) {
+            auto it = old.resources.find(id);
+            fresh->resources.emplace(id, it != old.resources.end() ? it->second : cell(res));
+        }
+        for (auto& [id, agent] : rm_.agents_) {
+            auto it = old.agents.find(id);
+            fresh->agents.emplace(id, it != old.agents.end() ? it->second : cell(agent));
+        }
+        std::shared_ptr<const PublishedIndex> published = std::move(fresh);
+        std::atomic_store_explicit(&rm_.published_, std::move(published),
+                                   std::memory_order_release);
+    }
+
+    // The verdict. A grant that passed the Banker's check leaves the state
+    // safe, and a release cannot make a safe state unsafe; anything else is
+    // checked against the live matrix.
+    void granted() { rm_.published_safe_.store(true, std::memory_order_relaxed); }
+
+    void released() {
+        if (!rm_.published_safe_.load(std::memory_order_relaxed)) recheck();
+    }
+
+    void recheck() {
+        bool safe = rm_.safety_checker_.check_safety(rm_.safety_matrix_).is_safe;
+        rm_.published_safe_.store(safe, std::memory_order_relaxed);
+    }
+
+private:
+    // Only writers replace the index, and they hold the exclusive lock
+    const PublishedIndex& index() const { return *rm_.published_; }
+
+    template <typename T>
+    static std::shared_ptr<PublishedCell<T>> cell(const T& value) {
+        auto c = std::make_shared<PublishedCell<T>>();
+        c->value = std::make_shared<const T>(value);
+        return c;
+    }
+
+    template <typename T>
+    static void store(PublishedCell<T>& c, const T& value) {
+        std::shared_ptr<const T> copy = std::make_shared<const T>(value);
+        std::atomic_store_explicit(&c.value, std::move(copy), std::memory_order_release);
+    }
+
+    ResourceManager& rm_;
+};
+
+// ==================== Admission ====================
+
+struct ResourceManager::AdmissionSlot {
+    AgentId agent_id{0};
+    ResourceTypeId resource_type{0};
+    ResourceQuantity quantity{0};
+
+    // Filled in by whichever thread evaluates the slot
+    bool done{false};
+    bool checked{false};  // enough was available to run a safety check
+    SafetyCheckResult result;
+    std::optional<double> duration_us;
+    Priority priority{PRIORITY_NORMAL};
+    ResourceQuantity level{0};  // allocation after a grant
+};
+
+void ResourceManager::admit(AdmissionSlot& slot) {
+    if (!config_.admission.group_commit) {
+        std::unique_lock lock(state_mutex_);
+        SpanTimer hold(wants_duration(EventType::LockHeld));
+        admit_locked(slot);
+        auto held_us = hold.elapsed_us();
+        lock.unlock();
+        emit_event(EventType::LockHeld, "Admission", slot.agent_id, slot.resource_type,
+                   std::nullopt, slot.quantity, std::nullopt, held_us, slot.priority);
+        return;
+    }
+
+    const std::size_t max_batch = std::max<std::size_t>(config_.admission.max_batch, 1);
+    std::unique_lock lock(admission_mutex_);
+    admission_queue_.push_back(&slot);
+    if (admission_queue_.size() >= max_batch) batch_full_cv_.notify_one();
+
+    while (!slot.done) {
+        if (combining_) {
+            admission_cv_.wait(lock);
+            continue;
+        }
+
+        combining_ = true;
+        if (config_.admission.window > Duration::zero()) {
+            batch_full_cv_.wait_for(lock, config_.admission.window, [&] {
+                return admission_queue_.size() >= max_batch;
+            });
+        }
+
+        // Serve batches in arrival order until our own slot is answered;
+        // anything left is picked up by the next combiner
+        while (!slot.done) {
+            std::size_t n = std::min(admission_queue_.size(), max_batch);
+            std::vector<AdmissionSlot*> batch(admission_queue_.begin(),
+                                              admission_queue_.begin() + static_cast<std::ptrdiff_t>(n));
+            admission_queue_.erase(admission_queue_.begin(),
+                                   admission_queue_.begin() + static_cast<std::ptrdiff_t>(n));
+            lock.unlock();
+            std::optional<double> held_us;
+            {
+                // Greedy: each attempt sees the grants made before it
+                std::unique_lock state_lock(state_mutex_);
+                SpanTimer hold(wants_duration(EventType::LockHeld));
+                for (AdmissionSlot* pending : batch) admit_locked(*pending);
+                held_us = hold.elapsed_us();
+            }
+            emit_event(EventType::LockHeld, "Group admission", std::nullopt, std::nullopt,
+                       std::nullopt, static_cast<ResourceQuantity>(batch.size()),
+                       std::nullopt, held_us);
+            lock.lock();
+            for (AdmissionSlot* pending : batch) pending->done = true;
+            admission_cv_.notify_all();
+        }
+
+        combining_ = false;
+        if (!admission_queue_.empty()) admission_cv_.notify_all();
+    }
+}
+
+void ResourceManager::admit_locked(AdmissionSlot& slot) {
+    auto res_it = resources_.find(slot.resource_type);
+    auto agent_it = agents_.find(slot.agent_id);
+    if (res_it == resources_.end() || agent_it == agents_.end()) return;
+    if (res_it->second.available() < slot.quantity) return;
+
+    // Check if granting would keep us in a safe state
+    slot.checked = true;
+    slot.priority = agent_it->second.priority();
+    SpanTimer timer(wants_duration(EventType::SafetyCheckPerformed));
+    slot.result = check_grant(slot.agent_id, slot.resource_type, slot.quantity);
+    slot.duration_us = timer.elapsed_us();
+
+    if (slot.result.is_safe) {
+        commit_allocation(agent_it->second, res_it->second, slot.quantity);
+        auto& alloc = agent_it->second.current_allocation();
+        auto alloc_it = alloc.find(slot.resource_type);
+        slot.level = (alloc_it != alloc.end()) ? alloc_it->second : 0;
+    }
+}
+
+// ==================== Construction ====================
+
 ResourceManager::ResourceManager(Config config)
     : config_(std::move(config))
+    , safety_checker_(config_.safety_algorithm, config_.use_simd_kernels)
     , request_queue_(config_.max_queue_size)
     , scheduling_policy_(std::make_unique<FifoPolicy>())
     , demand_estimator_(config_.adaptive)
+    , replenish_wheel_(config_.replenish.tick, config_.replenish.wheel_slots)
 {
     if (config_.progress.enabled) {
         progress_tracker_ = std::make_unique<ProgressTracker>(config_.progress);
@@ -17,10 +370,20 @@ ResourceManager::ResourceManager(Config config)
     if (config_.delegation.enabled) {
         delegation_tracker_ = std::make_unique<DelegationTracker>(config_.delegation);
     }
+    if (config_.executor.mode == CallbackExecution::ThreadPool) {
+        set_executor(std::make_shared<ThreadPoolExecutor>(config_.executor.threads));
+    } else {
+        set_executor(std::make_shared<InlineExecutor>());
+    }
 }
 
 ResourceManager::~ResourceManager() {
     stop();
+    // Requests parked without the processor ever running
+    request_queue_.cancel_all();
+    // Run outstanding callbacks while the manager is still intact
+    request_queue_.set_executor(nullptr);
+    executor_.reset();
 }
 
 // ==================== Resource Registration ====================
@@ -28,8 +391,26 @@ ResourceManager::~ResourceManager() {
 void ResourceManager::register_resource(Resource resource) {
     std::unique_lock lock(state_mutex_);
     auto id = resource.id();
-    resources_.emplace(id, std::move(resource));
+    auto [res_it, inserted] = resources_.emplace(id, std::move(resource));
+    if (inserted) {
+        std::size_t col = safety_matrix_.add_resource(id);
+        safety_matrix_.set_total(col, res_it->second.total_capacity());
+        safety_matrix_.set_available(col, safety_available(res_it->second));
+        // Agents may have declared needs before the resource existed
+        for (auto& [aid, agent] : agents_) {
+            auto max_it = agent.max_needs().find(id);
+            if (max_it != agent.max_needs().end()) {
+                safety_matrix_.set_max_need(safety_matrix_.agent_slot(aid), col,
+                                            max_it->second);
+            }
+        }
+        invalidate_headroom();
+        PublishScope publish(*this);
+        publish.entities();
+        publish.recheck();
+    }
     lock.unlock();
+    if (inserted) mark_resource_freed(id);
     emit_event(EventType::ResourceRegistered, "Resource registered",
                std::nullopt, id);
 }
@@ -40,6 +421,18 @@ bool ResourceManager::unregister_resource(ResourceTypeId id) {
     if (it == resources_.end()) return false;
     if (it->second.allocated() > 0) return false;
     resources_.erase(it);
+    replenish_.erase(id);  // its pending timer fires as a no-op
+    safety_matrix_.remove_resource(id);
+    invalidate_headroom();
+    {
+        PublishScope publish(*this);
+        publish.entities();
+        publish.released();
+    }
+    wake_all_waiters();
+    lock.unlock();
+    // Requests waiting on the resource are cancelled by the next pass
+    mark_rescan_all();
     return true;
 }
 
@@ -47,9 +440,22 @@ bool ResourceManager::adjust_resource_capacity(ResourceTypeId id, ResourceQuanti
     std::unique_lock lock(state_mutex_);
     auto it = resources_.find(id);
     if (it == resources_.end()) return false;
+    bool grew = new_capacity > it->second.total_capacity();
     bool ok = it->second.set_total_capacity(new_capacity);
     if (ok) {
+        std::size_t col = safety_matrix_.resource_slot(id);
+        safety_matrix_.set_total(col, it->second.total_capacity());
+        safety_matrix_.set_available(col, safety_available(it->second));
+        invalidate_headroom();
+        {
+            PublishScope publish(*this);
+            publish.resource(it->second);
+            publish.recheck();
+        }
+        wake_waiters(id);
         lock.unlock();
+        if (grew) mark_resource_freed(id);
+        else mark_resource_dirty(id);
         emit_event(EventType::ResourceCapacityChanged, "Capacity adjusted",
                    std::nullopt, id, std::nullopt, new_capacity);
     }
@@ -57,18 +463,18 @@ bool ResourceManager::adjust_resource_capacity(ResourceTypeId id, ResourceQuanti
 }
 
 std::optional<Resource> ResourceManager::get_resource(ResourceTypeId id) const {
-    std::shared_lock lock(state_mutex_);
-    auto it = resources_.find(id);
-    if (it == resources_.end()) return std::nullopt;
-    return it->second;
+    auto index = std::atomic_load_explicit(&published_, std::memory_order_acquire);
+    auto it = index->resources.find(id);
+    if (it == index->resources.end()) return std::nullopt;
+    return *std::atomic_load_explicit(&it->second->value, std::memory_order_acquire);
 }
 
 std::vector<Resource> ResourceManager::get_all_resources() const {
-    std::shared_lock lock(state_mutex_);
+    auto index = std::atomic_load_explicit(&published_, std::memory_order_acquire);
     std::vector<Resource> result;
-    result.reserve(resources_.size());
-    for (auto& [_, r] : resources_) {
-        result.push_back(r);
+    result.reserve(index->resources.size());
+    for (auto& [_, c] : index->resources) {
+        result.push_back(*std::atomic_load_explicit(&c->value, std::memory_order_acquire));
     }
     return result;
 }
@@ -89,14 +495,26 @@ AgentId ResourceManager::register_agent(Agent agent) {
     if (!agent.task_description().empty()) {
         registered.set_task_description(agent.task_description());
     }
-    agents_.emplace(id, std::move(registered));
+    auto& stored = agents_.emplace(id, std::move(registered)).first->second;
+    std::size_t row = safety_matrix_.add_agent(id);
+    for (auto& [rt, qty] : stored.max_needs()) {
+        std::size_t col = safety_matrix_.resource_slot(rt);
+        if (col != SafetyMatrix::npos) safety_matrix_.set_max_need(row, col, qty);
+    }
+    invalidate_headroom();
+    {
+        PublishScope publish(*this);
+        publish.entities();
+        publish.recheck();
+    }
     lock.unlock();
 
     if (progress_tracker_) progress_tracker_->register_agent(id);
     if (delegation_tracker_) delegation_tracker_->register_agent(id);
 
-    emit_event(EventType::AgentRegistered, "Agent registered: " + agent.name(),
-               id);
+    if (wants_event(EventType::AgentRegistered)) {
+        emit_event(EventType::AgentRegistered, "Agent registered: " + agent.name(), id);
+    }
     return id;
 }
 
@@ -106,15 +524,30 @@ bool ResourceManager::deregister_agent(AgentId id) {
     if (it == agents_.end()) return false;
 
     // Release all resources held by this agent
+    safety_matrix_.remove_agent(id);
     for (auto& [rt, qty] : it->second.current_allocation()) {
         auto res_it = resources_.find(rt);
         if (res_it != resources_.end()) {
             res_it->second.deallocate(qty);
+            safety_matrix_.set_available(safety_matrix_.resource_slot(rt),
+                                         safety_available(res_it->second));
         }
     }
 
+    auto held = it->second.current_allocation();
     std::string name = it->second.name();
     agents_.erase(it);
+    invalidate_headroom();
+    {
+        PublishScope publish(*this);
+        publish.entities();
+        for (auto& [rt, qty] : held) {
+            auto res_it = resources_.find(rt);
+            if (res_it != resources_.end()) publish.resource(res_it->second);
+        }
+        publish.released();
+    }
+    wake_all_waiters();
     lock.unlock();
 
     if (progress_tracker_) progress_tracker_->deregister_agent(id);
@@ -123,11 +556,12 @@ bool ResourceManager::deregister_agent(AgentId id) {
 
     // Cancel all pending requests for this agent
     request_queue_.cancel_all_for_agent(id);
+    // Both its allocation and its outstanding claims are gone
+    mark_rescan_all();
 
-    emit_event(EventType::AgentDeregistered, "Agent deregistered: " + name, id);
-
-    // Notify the processor to re-evaluate pending requests
-    release_cv_.notify_all();
+    if (wants_event(EventType::AgentDeregistered)) {
+        emit_event(EventType::AgentDeregistered, "Agent deregistered: " + name, id);
+    }
     return true;
 }
 
@@ -144,262 +578,379 @@ bool ResourceManager::update_agent_max_claim(AgentId id, ResourceTypeId resource
     if (new_max < current) return false;  // Can't reduce below current allocation
 
     it->second.declare_max_need(resource_type, new_max);
+    std::size_t col = safety_matrix_.resource_slot(resource_type);
+    if (col != SafetyMatrix::npos) {
+        safety_matrix_.set_max_need(safety_matrix_.agent_slot(id), col, new_max);
+    }
+    invalidate_headroom();
+    {
+        PublishScope publish(*this);
+        publish.agent(it->second);
+        publish.recheck();
+    }
+    wake_all_waiters();
+    lock.unlock();
+    // A lower claim can make previously unsafe requests safe
+    mark_rescan_all();
     return true;
 }
 
 std::optional<Agent> ResourceManager::get_agent(AgentId id) const {
-    std::shared_lock lock(state_mutex_);
-    auto it = agents_.find(id);
-    if (it == agents_.end()) return std::nullopt;
-    return it->second;
+    auto index = std::atomic_load_explicit(&published_, std::memory_order_acquire);
+    auto it = index->agents.find(id);
+    if (it == index->agents.end()) return std::nullopt;
+    return *std::atomic_load_explicit(&it->second->value, std::memory_order_acquire);
 }
 
 std::vector<Agent> ResourceManager::get_all_agents() const {
-    std::shared_lock lock(state_mutex_);
+    auto index = std::atomic_load_explicit(&published_, std::memory_order_acquire);
     std::vector<Agent> result;
-    result.reserve(agents_.size());
-    for (auto& [_, a] : agents_) {
-        result.push_back(a);
+    result.reserve(index->agents.size());
+    for (auto& [_, c] : index->agents) {
+        result.push_back(*std::atomic_load_explicit(&c->value, std::memory_order_acquire));
     }
     return result;
 }
 
 std::size_t ResourceManager::agent_count() const {
-    std::shared_lock lock(state_mutex_);
-    return agents_.size();
+    return std::atomic_load_explicit(&published_, std::memory_order_acquire)->agents.size();
 }
 
 // ==================== Synchronous Resource Requests ====================
 
-RequestStatus ResourceManager::request_resources(
-    AgentId agent_id,
-    ResourceTypeId resource_type,
-    ResourceQuantity quantity,
-    std::optional<Duration> timeout)
-{
-    // Validate the request
-    {
-        std::shared_lock lock(state_mutex_);
-        auto agent_it = agents_.find(agent_id);
-        if (agent_it == agents_.end()) {
-            throw AgentNotFoundException(agent_id);
-        }
-        auto res_it = resources_.find(resource_type);
-        if (res_it == resources_.end()) {
-            throw ResourceNotFoundException(resource_type);
-        }
+void ResourceManager::validate_request(AgentId agent_id, ResourceTypeId resource_type,
+                                       ResourceQuantity quantity) const {
+    std::shared_lock lock(state_mutex_);
+    auto agent_it = agents_.find(agent_id);
+    if (agent_it == agents_.end()) {
+        throw AgentNotFoundException(agent_id);
+    }
+    auto res_it = resources_.find(resource_type);
+    if (res_it == resources_.end()) {
+        throw ResourceNotFoundException(resource_type);
+    }
 
-        // Check if request exceeds max claim
-        auto max_it = agent_it->second.max_needs().find(resource_type);
-        if (max_it != agent_it->second.max_needs().end()) {
-            auto alloc = agent_it->second.current_allocation();
-            auto alloc_it = alloc.find(resource_type);
-            ResourceQuantity current = (alloc_it != alloc.end()) ? alloc_it->second : 0;
-            if (current + quantity > max_it->second) {
-                throw MaxClaimExceededException(agent_id, resource_type,
-                                                 quantity, max_it->second);
-            }
+    // Check if request exceeds max claim
+    auto max_it = agent_it->second.max_needs().find(resource_type);
+    if (max_it != agent_it->second.max_needs().end()) {
+        auto alloc = agent_it->second.current_allocation();
+        auto alloc_it = alloc.find(resource_type);
+        ResourceQuantity current = (alloc_it != alloc.end()) ? alloc_it->second : 0;
+        if (current + quantity > max_it->second) {
+            throw MaxClaimExceededException(agent_id, resource_type,
+                                             quantity, max_it->second);
         }
+    }
 
-        // Check if request exceeds total capacity
-        if (quantity > res_it->second.total_capacity()) {
-            throw ResourceCapacityExceededException(resource_type, quantity,
-                                                     res_it->second.total_capacity());
-        }
+    // Check if request exceeds total capacity
+    if (quantity > res_it->second.total_capacity()) {
+        throw ResourceCapacityExceededException(resource_type, quantity,
+                                                 res_it->second.total_capacity());
     }
+}
 
+bool ResourceManager::admit_first(AgentId agent_id, ResourceTypeId resource_type,
+                                  ResourceQuantity quantity, const SpanTimer& wait_timer) {
     emit_event(EventType::RequestSubmitted, "Request submitted",
                agent_id, resource_type, std::nullopt, quantity);
 
     demand_estimator_.record_request(agent_id, resource_type, quantity);
 
-    // Try to grant immediately
-    {
-        std::unique_lock lock(state_mutex_);
-        auto& res = resources_.at(resource_type);
+    AdmissionSlot admission;
+    admission.agent_id = agent_id;
+    admission.resource_type = resource_type;
+    admission.quantity = quantity;
+    admit(admission);
+    if (!admission.checked) return false;
 
-        if (res.available() >= quantity) {
-            // Check if granting would keep us in a safe state
-            auto input = build_safety_input();
-            auto t0 = std::chrono::steady_clock::now();
-            auto result = safety_checker_.check_hypothetical(
-                input, agent_id, resource_type, quantity);
-            auto t1 = std::chrono::steady_clock::now();
-            double dur_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
-
-            emit_event(EventType::SafetyCheckPerformed, result.reason,
-                       agent_id, resource_type, std::nullopt, quantity,
-                       result.is_safe, dur_us);
+    emit_event(EventType::SafetyCheckPerformed, admission.result.reason,
+               agent_id, resource_type, std::nullopt, quantity,
+               admission.result.is_safe, admission.duration_us, admission.priority);
 
-            if (result.is_safe) {
-                // Grant!
-                res.allocate(quantity);
-                agents_.at(agent_id).allocate(resource_type, quantity);
-                auto alloc = agents_.at(agent_id).current_allocation();
-                auto alloc_it = alloc.find(resource_type);
-                ResourceQuantity level = (alloc_it != alloc.end()) ? alloc_it->second : 0;
-                lock.unlock();
-                demand_estimator_.record_allocation_level(agent_id, resource_type, level);
-                emit_event(EventType::RequestGranted, "Granted immediately",
-                           agent_id, resource_type, std::nullopt, quantity);
-                return RequestStatus::Granted;
-            } else {
-                emit_event(EventType::UnsafeStateDetected,
-                          "Would create unsafe state", agent_id, resource_type);
-            }
-        }
+    if (admission.result.is_safe) {
+        demand_estimator_.record_allocation_level(agent_id, resource_type, admission.level);
+        emit_event(EventType::RequestGranted, "Granted immediately",
+                   agent_id, resource_type, std::nullopt, quantity,
+                   std::nullopt, wait_timer.elapsed_us(), admission.priority);
+        return true;
+    }
+    emit_event(EventType::UnsafeStateDetected,
+              "Would create unsafe state", agent_id, resource_type);
+    return false;
+}
+
+RequestStatus ResourceManager::request_resources(
+    AgentId agent_id,
+    ResourceTypeId resource_type,
+    ResourceQuantity quantity,
+    std::optional<Duration> timeout)
+{
+    validate_request(agent_id, resource_type, quantity);
+    SpanTimer wait_timer(wants_duration(EventType::RequestGranted));
+    if (admit_first(agent_id, resource_type, quantity, wait_timer)) {
+        return RequestStatus::Granted;
     }
 
     // Can't grant immediately - wait with timeout
     Duration wait_timeout = timeout.value_or(config_.default_request_timeout);
     auto deadline = Clock::now() + wait_timeout;
 
+    WaiterScope waiter(*this, agent_id, {{resource_type, quantity}});
     while (Clock::now() < deadline) {
-        {
-            std::unique_lock lock(state_mutex_);
-
-            auto res_it = resources_.find(resource_type);
-            if (res_it == resources_.end()) return RequestStatus::Denied;
-            auto agent_it = agents_.find(agent_id);
-            if (agent_it == agents_.end()) return RequestStatus::Denied;
-
-            if (res_it->second.available() >= quantity) {
-                auto input = build_safety_input();
-                auto t0 = std::chrono::steady_clock::now();
-                auto result = safety_checker_.check_hypothetical(
-                    input, agent_id, resource_type, quantity);
-                auto t1 = std::chrono::steady_clock::now();
-                double dur_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
-
-                emit_event(EventType::SafetyCheckPerformed, result.reason,
-                           agent_id, resource_type, std::nullopt, quantity,
-                           result.is_safe, dur_us);
-
-                if (result.is_safe) {
-                    res_it->second.allocate(quantity);
-                    agent_it->second.allocate(resource_type, quantity);
-                    auto alloc = agent_it->second.current_allocation();
-                    auto a_it = alloc.find(resource_type);
-                    ResourceQuantity level = (a_it != alloc.end()) ? a_it->second : 0;
-                    lock.unlock();
-                    demand_estimator_.record_allocation_level(agent_id, resource_type, level);
-                    emit_event(EventType::RequestGranted, "Granted after waiting",
-                               agent_id, resource_type, std::nullopt, quantity);
-                    return RequestStatus::Granted;
-                }
-                // Resources available but unsafe - if no background processor
-                // running, state won't change, so deny immediately
-                if (!running_.load()) {
-                    lock.unlock();
-                    emit_event(EventType::RequestDenied,
-                              "Unsafe state and no processor running",
-                              agent_id, resource_type, std::nullopt, quantity);
-                    return RequestStatus::Denied;
-                }
-            }
+        auto res_it = resources_.find(resource_type);
+        if (res_it == resources_.end()) return RequestStatus::Denied;
+        auto agent_it = agents_.find(agent_id);
+        if (agent_it == agents_.end()) return RequestStatus::Denied;
+
+        bool unsafe = false;
+        if (res_it->second.available() >= quantity) {
+            SpanTimer timer(wants_duration(EventType::SafetyCheckPerformed));
+            auto result = check_grant(agent_id, resource_type, quantity);
 
-            // Wait for a release event or timeout
-            auto remaining = deadline - Clock::now();
-            if (remaining <= Duration::zero()) break;
+            Priority priority = agent_it->second.priority();
+            waiter.defer(make_event(EventType::SafetyCheckPerformed, result.reason,
+                                    agent_id, resource_type, std::nullopt, quantity,
+                                    result.is_safe, timer.elapsed_us(), priority));
 
-            release_cv_.wait_for(lock, std::min(remaining, config_.processor_poll_interval));
+            if (result.is_safe) {
+                commit_allocation(agent_it->second, res_it->second, quantity);
+                auto alloc = agent_it->second.current_allocation();
+                auto a_it = alloc.find(resource_type);
+                ResourceQuantity level = (a_it != alloc.end()) ? a_it->second : 0;
+                waiter.unlock();
+                demand_estimator_.record_allocation_level(agent_id, resource_type, level);
+                emit_event(EventType::RequestGranted, "Granted after waiting",
+                           agent_id, resource_type, std::nullopt, quantity,
+                           std::nullopt, wait_timer.elapsed_us(), priority);
+                return RequestStatus::Granted;
+            }
+            // Resources available but unsafe - if no background processor
+            // running, state won't change, so deny immediately
+            if (!running_.load()) {
+                waiter.unlock();
+                emit_event(EventType::RequestDenied,
+                          "Unsafe state and no processor running",
+                          agent_id, resource_type, std::nullopt, quantity);
+                return RequestStatus::Denied;
+            }
+            unsafe = true;
         }
+
+        // Wait for a release that fits this request, or timeout
+        waiter.set_unsafe(unsafe);
+        if (!waiter.wait(deadline)) break;
     }
+    waiter.unlock();
 
     emit_event(EventType::RequestTimedOut, "Request timed out",
                agent_id, resource_type, std::nullopt, quantity);
     return RequestStatus::TimedOut;
 }
 
-RequestStatus ResourceManager::request_resources_batch(
+ElasticGrant ResourceManager::request_resources_elastic(
     AgentId agent_id,
-    const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+    ResourceTypeId resource_type,
+    ResourceQuantity min_quantity,
+    ResourceQuantity max_quantity,
     std::optional<Duration> timeout)
 {
-    // Validate all requests
-    {
-        std::shared_lock lock(state_mutex_);
-        auto agent_it = agents_.find(agent_id);
-        if (agent_it == agents_.end()) {
-            throw AgentNotFoundException(agent_id);
-        }
-        for (auto& [rt, qty] : requests) {
-            auto res_it = resources_.find(rt);
-            if (res_it == resources_.end()) {
-                throw ResourceNotFoundException(rt);
-            }
-        }
+    if (min_quantity < 1 || min_quantity > max_quantity) {
+        throw InvalidRequestException("Elastic request needs 1 <= min_quantity <= max_quantity");
     }
+    validate_request(agent_id, resource_type, min_quantity);
+
+    SpanTimer wait_timer(wants_duration(EventType::RequestGranted));
+    emit_event(EventType::RequestSubmitted, "Elastic request submitted",
+               agent_id, resource_type, std::nullopt, max_quantity);
+    demand_estimator_.record_request(agent_id, resource_type, max_quantity);
 
     Duration wait_timeout = timeout.value_or(config_.default_request_timeout);
     auto deadline = Clock::now() + wait_timeout;
 
-    while (Clock::now() < deadline) {
-        std::unique_lock lock(state_mutex_);
+    WaiterScope waiter(*this, agent_id, {{resource_type, min_quantity}});
+    for (;;) {
+        auto res_it = resources_.find(resource_type);
+        if (res_it == resources_.end()) return {RequestStatus::Denied, 0};
+        auto agent_it = agents_.find(agent_id);
+        if (agent_it == agents_.end()) return {RequestStatus::Denied, 0};
+
+        bool unsafe = false;
+        if (res_it->second.available() >= min_quantity) {
+            SpanTimer timer(wants_duration(EventType::SafetyCheckPerformed));
+            ResourceQuantity granted =
+                largest_safe_grant(agent_id, resource_type, min_quantity, max_quantity);
+
+            Priority priority = agent_it->second.priority();
+            if (wants_event(EventType::SafetyCheckPerformed)) {
+                waiter.defer(make_event(
+                    EventType::SafetyCheckPerformed,
+                    granted > 0 ? "Largest safe grant is " + std::to_string(granted)
+                                : "No safe grant of at least " + std::to_string(min_quantity),
+                    agent_id, resource_type, std::nullopt, granted,
+                    granted > 0, timer.elapsed_us(), priority));
+            }
 
-        // Check if all resources are available
-        bool all_available = true;
-        for (auto& [rt, qty] : requests) {
-            auto res_it = resources_.find(rt);
-            if (res_it == resources_.end() || res_it->second.available() < qty) {
-                all_available = false;
-                break;
+            if (granted > 0) {
+                commit_allocation(agent_it->second, res_it->second, granted);
+                auto alloc = agent_it->second.current_allocation();
+                auto a_it = alloc.find(resource_type);
+                ResourceQuantity level = (a_it != alloc.end()) ? a_it->second : 0;
+                waiter.unlock();
+                demand_estimator_.record_allocation_level(agent_id, resource_type, level);
+                emit_event(EventType::RequestGranted, "Elastic request granted",
+                           agent_id, resource_type, std::nullopt, granted,
+                           std::nullopt, wait_timer.elapsed_us(), priority);
+                return {RequestStatus::Granted, granted};
             }
+            if (!running_.load()) {
+                waiter.unlock();
+                emit_event(EventType::RequestDenied,
+                          "Unsafe state and no processor running",
+                          agent_id, resource_type, std::nullopt, min_quantity);
+                return {RequestStatus::Denied, 0};
+            }
+            unsafe = true;
         }
 
-        if (all_available) {
-            // Build hypothetical batch
-            auto input = build_safety_input();
-            std::vector<ResourceRequest> batch;
-            for (auto& [rt, qty] : requests) {
-                ResourceRequest req;
-                req.agent_id = agent_id;
-                req.resource_type = rt;
-                req.quantity = qty;
-                batch.push_back(req);
-            }
+        // Wait for a release that fits the minimum, or timeout
+        waiter.set_unsafe(unsafe);
+        if (!waiter.wait(deadline)) break;
+    }
+    waiter.unlock();
+
+    emit_event(EventType::RequestTimedOut, "Elastic request timed out",
+               agent_id, resource_type, std::nullopt, min_quantity);
+    return {RequestStatus::TimedOut, 0};
+}
+
+RequestStatus ResourceManager::request_resources_batch(
+    AgentId agent_id,
+    const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+    std::optional<Duration> timeout)
+{
+    validate_batch(agent_id, requests);
+    std::vector<ResourceDemand> parts;
+    for (auto& [rt, qty] : requests) parts.push_back({rt, qty});
+
+    SpanTimer wait_timer(wants_duration(EventType::RequestGranted));
+    Duration wait_timeout = timeout.value_or(config_.default_request_timeout);
+    auto deadline = Clock::now() + wait_timeout;
 
-            auto t0 = std::chrono::steady_clock::now();
-            auto result = safety_checker_.check_hypothetical_batch(input, batch);
-            auto t1 = std::chrono::steady_clock::now();
-            double dur_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    WaiterScope waiter(*this, agent_id, {requests.begin(), requests.end()});
+    while (Clock::now() < deadline) {
+        SpanTimer timer(wants_duration(EventType::SafetyCheckPerformed));
+        auto checked = check_bundle(agent_id, parts);
+        bool all_available = checked.has_value();
 
-            emit_event(EventType::SafetyCheckPerformed, result.reason,
-                       agent_id, std::nullopt, std::nullopt, std::nullopt,
-                       result.is_safe, dur_us);
+        if (all_available) {
+            auto& result = *checked;
+            auto& agent = agents_.at(agent_id);
+            Priority priority = agent.priority();
+            waiter.defer(make_event(EventType::SafetyCheckPerformed, result.reason,
+                                    agent_id, std::nullopt, std::nullopt, std::nullopt,
+                                    result.is_safe, timer.elapsed_us(), priority));
 
             if (result.is_safe) {
                 // Grant all atomically
                 for (auto& [rt, qty] : requests) {
-                    resources_.at(rt).allocate(qty);
-                    agents_.at(agent_id).allocate(rt, qty);
+                    commit_allocation(agent, resources_.at(rt), qty);
                 }
-                lock.unlock();
+                waiter.unlock();
                 emit_event(EventType::RequestGranted, "Batch granted",
-                           agent_id);
+                           agent_id, std::nullopt, std::nullopt, std::nullopt,
+                           std::nullopt, wait_timer.elapsed_us(), priority);
                 return RequestStatus::Granted;
             }
 
             // Resources available but unsafe - if no background processor
             // running, state won't change, so deny immediately
             if (!running_.load()) {
-                lock.unlock();
+                waiter.unlock();
                 emit_event(EventType::RequestDenied,
                           "Batch unsafe and no processor running", agent_id);
                 return RequestStatus::Denied;
             }
         }
 
-        auto remaining = deadline - Clock::now();
-        if (remaining <= Duration::zero()) break;
-
-        release_cv_.wait_for(lock, std::min(remaining, config_.processor_poll_interval));
+        waiter.set_unsafe(all_available);
+        if (!waiter.wait(deadline)) break;
     }
+    waiter.unlock();
 
     emit_event(EventType::RequestTimedOut, "Batch request timed out", agent_id);
     return RequestStatus::TimedOut;
 }
 
+void ResourceManager::validate_batch(
+    AgentId agent_id,
+    const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests) const
+{
+    std::shared_lock lock(state_mutex_);
+    if (agents_.find(agent_id) == agents_.end()) {
+        throw AgentNotFoundException(agent_id);
+    }
+    for (auto& [rt, qty] : requests) {
+        if (resources_.find(rt) == resources_.end()) {
+            throw ResourceNotFoundException(rt);
+        }
+    }
+}
+
+std::optional<SafetyCheckResult> ResourceManager::check_bundle(
+    AgentId agent_id, const std::vector<ResourceDemand>& parts)
+{
+    std::vector<ResourceRequest> batch;
+    batch.reserve(parts.size());
+    for (auto& part : parts) {
+        auto res_it = resources_.find(part.resource_type);
+        if (res_it == resources_.end() || res_it->second.available() < part.quantity) {
+            return std::nullopt;
+        }
+        ResourceRequest req;
+        req.agent_id = agent_id;
+        req.resource_type = part.resource_type;
+        req.quantity = part.quantity;
+        batch.push_back(std::move(req));
+    }
+
+    auto result = safety_checker_.check_hypothetical_batch_in_place(safety_matrix_, batch);
+    if (result.is_safe) safe_sequence_ = result.safe_sequence;
+    return result;
+}
+
+bool ResourceManager::admit_bundle(AgentId agent_id, const std::vector<ResourceDemand>& parts,
+                                   const SpanTimer& wait_timer) {
+    emit_event(EventType::RequestSubmitted, "Batch submitted", agent_id);
+
+    std::unique_lock lock(state_mutex_);
+    auto agent_it = agents_.find(agent_id);
+    if (agent_it == agents_.end()) return false;
+
+    SpanTimer timer(wants_duration(EventType::SafetyCheckPerformed));
+    auto checked = check_bundle(agent_id, parts);
+    if (!checked) return false;
+
+    Priority priority = agent_it->second.priority();
+    auto check_event = make_event(EventType::SafetyCheckPerformed, checked->reason,
+                                  agent_id, std::nullopt, std::nullopt, std::nullopt,
+                                  checked->is_safe, timer.elapsed_us(), priority);
+    if (!checked->is_safe) {
+        lock.unlock();
+        emit_event(check_event);
+        return false;
+    }
+
+    for (auto& part : parts) {
+        commit_allocation(agent_it->second, resources_.at(part.resource_type), part.quantity);
+    }
+    lock.unlock();
+    emit_event(check_event);
+    emit_event(EventType::RequestGranted, "Batch granted immediately",
+               agent_id, std::nullopt, std::nullopt, std::nullopt,
+               std::nullopt, wait_timer.elapsed_us(), priority);
+    return true;
+}
+
 // ==================== Asynchronous Resource Requests ====================
 
 std::future<RequestStatus> ResourceManager::request_resources_async(
@@ -408,9 +959,40 @@ std::future<RequestStatus> ResourceManager::request_resources_async(
     ResourceQuantity quantity,
     std::optional<Duration> timeout)
 {
-    return std::async(std::launch::async, [this, agent_id, resource_type, quantity, timeout] {
-        return request_resources(agent_id, resource_type, quantity, timeout);
-    });
+    auto promise = std::make_shared<std::promise<RequestStatus>>();
+    auto future = promise->get_future();
+    try {
+        if (admit_now(agent_id, resource_type, quantity)) {
+            promise->set_value(RequestStatus::Granted);
+            return future;
+        }
+    } catch (...) {
+        promise->set_exception(std::current_exception());
+        return future;
+    }
+
+    // Park it in the queue; no thread waits on it. The processor grants it,
+    // or expiry/cancellation resolves it, through the callback.
+    park(agent_id, resource_type, quantity,
+         [promise](RequestId, RequestStatus status) { promise->set_value(status); },
+         timeout);
+    return future;
+}
+
+bool ResourceManager::admit_now(AgentId agent_id, ResourceTypeId resource_type,
+                                ResourceQuantity quantity) {
+    validate_request(agent_id, resource_type, quantity);
+    SpanTimer wait_timer(wants_duration(EventType::RequestGranted));
+    return admit_first(agent_id, resource_type, quantity, wait_timer);
+}
+
+void ResourceManager::park(AgentId agent_id, ResourceTypeId resource_type,
+                           ResourceQuantity quantity, RequestCallback callback,
+                           std::optional<Duration> timeout) {
+    RequestId id = request_resources_callback(
+        agent_id, resource_type, quantity, std::move(callback),
+        timeout.value_or(config_.default_request_timeout));
+    cancel_if_stopped(id);
 }
 
 RequestId ResourceManager::request_resources_callback(
@@ -437,7 +1019,89 @@ RequestId ResourceManager::request_resources_callback(
         }
     }
 
-    return request_queue_.enqueue(std::move(req));
+    RequestId id = request_queue_.enqueue(std::move(req));
+    mark_resource_dirty(resource_type);
+    return id;
+}
+
+std::future<RequestStatus> ResourceManager::request_resources_batch_async(
+    AgentId agent_id,
+    const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+    std::optional<Duration> timeout)
+{
+    auto promise = std::make_shared<std::promise<RequestStatus>>();
+    auto future = promise->get_future();
+    try {
+        if (admit_now(agent_id, requests)) {
+            promise->set_value(RequestStatus::Granted);
+            return future;
+        }
+    } catch (...) {
+        promise->set_exception(std::current_exception());
+        return future;
+    }
+
+    park(agent_id, requests,
+         [promise](RequestId, RequestStatus status) { promise->set_value(status); },
+         timeout);
+    return future;
+}
+
+bool ResourceManager::admit_now(
+    AgentId agent_id, const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests)
+{
+    validate_batch(agent_id, requests);
+    std::vector<ResourceDemand> parts;
+    for (auto& [rt, qty] : requests) parts.push_back({rt, qty});
+    SpanTimer wait_timer(wants_duration(EventType::RequestGranted));
+    return parts.empty() || admit_bundle(agent_id, parts, wait_timer);
+}
+
+void ResourceManager::park(
+    AgentId agent_id, const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+    RequestCallback callback, std::optional<Duration> timeout)
+{
+    RequestId id = request_resources_batch_callback(
+        agent_id, requests, std::move(callback),
+        timeout.value_or(config_.default_request_timeout));
+    cancel_if_stopped(id);
+}
+
+void ResourceManager::cancel_if_stopped(RequestId id) {
+    // stop() sets stopped_ before it cancels the queue, so a request parked
+    // after that sweep is seen here; a no-op if already resolved. Before the
+    // first start() requests stay parked for the processor.
+    if (stopped_.load()) request_queue_.cancel(id);
+}
+
+RequestId ResourceManager::request_resources_batch_callback(
+    AgentId agent_id,
+    const std::unordered_map<ResourceTypeId, ResourceQuantity>& requests,
+    RequestCallback callback,
+    std::optional<Duration> timeout)
+{
+    if (requests.empty()) {
+        throw InvalidRequestException("Batch request names no resources");
+    }
+
+    ResourceRequest req;
+    req.agent_id = agent_id;
+    req.priority = PRIORITY_NORMAL;
+    req.timeout = timeout;
+    req.callback = std::move(callback);
+    for (auto& [rt, qty] : requests) req.bundle.push_back({rt, qty});
+
+    {
+        std::shared_lock lock(state_mutex_);
+        auto it = agents_.find(agent_id);
+        if (it != agents_.end()) {
+            req.priority = it->second.priority();
+        }
+    }
+
+    RequestId id = request_queue_.enqueue(std::move(req));
+    for (auto& [rt, qty] : requests) mark_resource_dirty(rt);
+    return id;
 }
 
 // ==================== Resource Release ====================
@@ -454,19 +1118,23 @@ void ResourceManager::release_resources(AgentId agent_id, ResourceTypeId resourc
         throw ResourceNotFoundException(resource_type);
     }
 
-    agent_it->second.deallocate(resource_type, quantity);
-    res_it->second.deallocate(quantity);
+    SpanTimer hold(wants_duration(EventType::LockHeld));
+    commit_release(agent_it->second, res_it->second, quantity);
     auto alloc = agent_it->second.current_allocation();
     auto a_it = alloc.find(resource_type);
     ResourceQuantity level = (a_it != alloc.end()) ? a_it->second : 0;
+    wake_waiters(resource_type);
+    Priority priority = agent_it->second.priority();
+    auto held_us = hold.elapsed_us();
     lock.unlock();
 
     demand_estimator_.record_allocation_level(agent_id, resource_type, level);
 
+    mark_resource_freed(resource_type);
     emit_event(EventType::ResourcesReleased, "Resources released",
                agent_id, resource_type, std::nullopt, quantity);
-
-    release_cv_.notify_all();
+    emit_event(EventType::LockHeld, "Release", agent_id, resource_type,
+               std::nullopt, quantity, std::nullopt, held_us, priority);
 }
 
 void ResourceManager::release_all_resources(AgentId agent_id, ResourceTypeId resource_type) {
@@ -479,17 +1147,20 @@ void ResourceManager::release_all_resources(AgentId agent_id, ResourceTypeId res
     if (alloc_it == alloc.end()) return;
 
     ResourceQuantity qty = alloc_it->second;
-    agent_it->second.deallocate(resource_type, qty);
 
     auto res_it = resources_.find(resource_type);
     if (res_it != resources_.end()) {
-        res_it->second.deallocate(qty);
+        commit_release(agent_it->second, res_it->second, qty);
+    } else {
+        agent_it->second.deallocate(resource_type, qty);
+        PublishScope(*this).agent(agent_it->second);
     }
+    wake_waiters(resource_type);
     lock.unlock();
 
+    mark_resource_freed(resource_type);
     emit_event(EventType::ResourcesReleased, "All resources released for type",
                agent_id, resource_type, std::nullopt, qty);
-    release_cv_.notify_all();
 }
 
 void ResourceManager::release_all_resources(AgentId agent_id) {
@@ -500,54 +1171,92 @@ void ResourceManager::release_all_resources(AgentId agent_id) {
     // Copy allocation to avoid modifying while iterating
     auto alloc_copy = agent_it->second.current_allocation();
     for (auto& [rt, qty] : alloc_copy) {
-        agent_it->second.deallocate(rt, qty);
         auto res_it = resources_.find(rt);
         if (res_it != resources_.end()) {
-            res_it->second.deallocate(qty);
+            commit_release(agent_it->second, res_it->second, qty);
+        } else {
+            agent_it->second.deallocate(rt, qty);
+            PublishScope(*this).agent(agent_it->second);
         }
     }
+    for (auto& [rt, qty] : alloc_copy) wake_waiters(rt);
+    lock.unlock();
+
+    for (auto& [rt, qty] : alloc_copy) mark_resource_freed(rt);
+    emit_event(EventType::ResourcesReleased, "All resources released",
+               agent_id);
+}
+
+void ResourceManager::consume_resources(AgentId agent_id, ResourceTypeId resource_type,
+                                        ResourceQuantity quantity) {
+    std::unique_lock lock(state_mutex_);
+    auto agent_it = agents_.find(agent_id);
+    if (agent_it == agents_.end()) {
+        throw AgentNotFoundException(agent_id);
+    }
+    auto res_it = resources_.find(resource_type);
+    if (res_it == resources_.end()) {
+        throw ResourceNotFoundException(resource_type);
+    }
+
+    Resource& res = res_it->second;
+    auto interval = res.replenish_interval();
+    if (!interval || *interval <= Duration::zero()) {
+        lock.unlock();
+        release_resources(agent_id, resource_type, quantity);
+        return;
+    }
+
+    // Only what the agent holds can be consumed
+    auto& alloc = agent_it->second.current_allocation();
+    auto a_it = alloc.find(resource_type);
+    ResourceQuantity held = (a_it != alloc.end()) ? a_it->second : 0;
+    quantity = std::min(quantity, held);
+    if (quantity <= 0) return;
+
+    auto now = Clock::now();
+    auto& state = replenish_[resource_type];
+    if (res.replenish_policy() == ReplenishPolicy::SlidingWindow) {
+        state.window.emplace_back(now + *interval, quantity);
+    } else if (res.consumed() == 0) {
+        // A full bucket starts accruing now
+        state.last_refill = now;
+        state.credit = 0.0;
+    }
+    agent_it->second.deallocate(resource_type, quantity);
+    res.consume(quantity);
+    sync_safety_cell(agent_it->second, res);
+    {
+        PublishScope publish(*this);
+        publish.agent(agent_it->second);
+        publish.resource(res);
+        publish.released();
+    }
+    ++headroom_releases_;
+    arm_replenish(res, state);
+    // Nothing became available, but to the safety check this is a release,
+    // so requests refused as unsafe get another look
+    wake_waiters(resource_type);
     lock.unlock();
 
-    emit_event(EventType::ResourcesReleased, "All resources released",
-               agent_id);
-    release_cv_.notify_all();
+    demand_estimator_.record_allocation_level(agent_id, resource_type, held - quantity);
+
+    // Also wakes the processor to pick up the new refill deadline
+    mark_resource_freed(resource_type);
+    emit_event(EventType::ResourcesConsumed, "Resources consumed",
+               agent_id, resource_type, std::nullopt, quantity);
 }
 
 // ==================== Queries ====================
 
 bool ResourceManager::is_safe() const {
-    std::shared_lock lock(state_mutex_);
-    auto input = build_safety_input();
-    auto result = safety_checker_.check_safety(input);
-    return result.is_safe;
+    return published_safe_.load(std::memory_order_acquire);
 }
 
 SystemSnapshot ResourceManager::get_snapshot() const {
-    std::shared_lock lock(state_mutex_);
-    SystemSnapshot snap;
+    SystemSnapshot snap = published_snapshot();
     snap.timestamp = Clock::now();
-
-    for (auto& [id, res] : resources_) {
-        snap.total_resources[id] = res.total_capacity();
-        snap.available_resources[id] = res.available();
-    }
-
-    for (auto& [id, agent] : agents_) {
-        AgentAllocationSnapshot as;
-        as.agent_id = id;
-        as.name = agent.name();
-        as.priority = agent.priority();
-        as.state = agent.state();
-        as.allocation = agent.current_allocation();
-        as.max_claim = agent.max_needs();
-        snap.agents.push_back(std::move(as));
-    }
-
     snap.pending_requests = request_queue_.size();
-
-    auto input = build_safety_input();
-    snap.is_safe = safety_checker_.check_safety(input).is_safe;
-
     return snap;
 }
 
@@ -555,6 +1264,18 @@ std::size_t ResourceManager::pending_request_count() const {
     return request_queue_.size();
 }
 
+std::uint64_t ResourceManager::waiter_wakeups() const noexcept {
+    return waiter_wakeups_.load(std::memory_order_relaxed);
+}
+
+SafetyCacheStats ResourceManager::safety_cache_stats() const {
+    SafetyCacheStats stats;
+    stats.hits = safety_cache_hits_.load(std::memory_order_relaxed);
+    stats.misses = safety_cache_misses_.load(std::memory_order_relaxed);
+    stats.headroom_hits = headroom_hits_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 // ==================== Configuration ====================
 
 void ResourceManager::set_scheduling_policy(std::unique_ptr<SchedulingPolicy> policy) {
@@ -562,12 +1283,38 @@ void ResourceManager::set_scheduling_policy(std::unique_ptr<SchedulingPolicy> po
 }
 
 void ResourceManager::set_monitor(std::shared_ptr<Monitor> monitor) {
+    // Its subscriptions are cached below, so a composite's children are fixed
+    auto target = monitor;
+    if (auto async = std::dynamic_pointer_cast<AsyncMonitor>(target)) target = async->inner();
+    if (auto composite = std::dynamic_pointer_cast<CompositeMonitor>(target)) composite->freeze();
+
+    if (monitor && config_.async_monitor.enabled) {
+        monitor = std::make_shared<AsyncMonitor>(std::move(monitor), config_.async_monitor);
+    }
     monitor_ = monitor;
+    event_mask_ = monitor_ ? monitor_->subscribed_events() : 0;
+    timed_events_ = (monitor_ && monitor_->consumes_durations())
+        ? event_mask_ & event_mask({EventType::SafetyCheckPerformed,
+                                    EventType::ProbabilisticSafetyCheck,
+                                    EventType::RequestGranted,
+                                    EventType::LockHeld})
+        : 0;
     if (delegation_tracker_) delegation_tracker_->set_monitor(monitor);
 }
 
+void ResourceManager::flush_events() {
+    if (auto async = std::dynamic_pointer_cast<AsyncMonitor>(monitor_)) async->flush();
+}
+
+void ResourceManager::set_executor(std::shared_ptr<Executor> executor) {
+    if (!executor) executor = std::make_shared<InlineExecutor>();
+    executor_ = executor;
+    request_queue_.set_executor(std::move(executor));
+}
+
 void ResourceManager::start() {
     if (running_.exchange(true)) return;  // Already running
+    stopped_.store(false);
 
     if (progress_tracker_) {
         // Stall action: auto-release all resources for the stalled agent
@@ -582,20 +1329,45 @@ void ResourceManager::start() {
         progress_tracker_->start(monitor_, std::move(stall_cb));
     }
 
+    mark_rescan_all();
     processor_thread_ = std::thread([this] { process_queue_loop(); });
+    if (config_.snapshot_interval > Duration::zero()) {
+        snapshot_thread_ = std::thread([this] { snapshot_loop(); });
+    }
 }
 
 void ResourceManager::stop() {
     if (!running_.exchange(false)) return;  // Already stopped
+    stopped_.store(true);
 
     if (progress_tracker_) progress_tracker_->stop();
 
-    release_cv_.notify_all();
+    {
+        // Waiters refused as unsafe deny once the processor is gone
+        std::unique_lock lock(state_mutex_);
+        wake_all_waiters();
+    }
     request_queue_.notify();
+    {
+        // Pairs with the processor's predicate check so the wakeup is not lost
+        std::lock_guard lock(pending_work_mutex_);
+    }
+    processor_cv_.notify_all();
 
     if (processor_thread_.joinable()) {
         processor_thread_.join();
     }
+
+    {
+        std::lock_guard lock(snapshot_mutex_);
+    }
+    snapshot_cv_.notify_all();
+    if (snapshot_thread_.joinable()) {
+        snapshot_thread_.join();
+    }
+
+    // Nothing will resolve what is still queued
+    request_queue_.cancel_all();
 }
 
 bool ResourceManager::is_running() const noexcept {
@@ -604,29 +1376,448 @@ bool ResourceManager::is_running() const noexcept {
 
 // ==================== Internal Helpers ====================
 
-SafetyCheckInput ResourceManager::build_safety_input() const {
-    // Caller must hold state_mutex_ (shared or exclusive)
-    SafetyCheckInput input;
+void ResourceManager::commit_allocation(Agent& agent, Resource& res,
+                                        ResourceQuantity quantity, bool checked) {
+    // Caller must hold exclusive state_mutex_
+    res.allocate(quantity);
+    agent.allocate(res.id(), quantity);
+    sync_safety_cell(agent, res);
+    {
+        PublishScope publish(*this);
+        publish.agent(agent);
+        publish.resource(res);
+        if (checked) publish.granted();
+        else publish.recheck();
+    }
 
-    for (auto& [id, res] : resources_) {
-        input.total[id] = res.total_capacity();
-        input.available[id] = res.available();
+    // Any grant can shrink every other cell's headroom. This cell's own
+    // bounds stay valid shifted by the grant: the same states lie beyond it.
+    std::size_t cell = safety_matrix_.agent_slot(agent.id()) * safety_matrix_.stride() +
+                       safety_matrix_.resource_slot(res.id());
+    bool keep = cell < headroom_.size() && headroom_[cell].epoch == headroom_epoch_;
+    invalidate_headroom();
+    if (keep) {
+        auto& entry = headroom_[cell];
+        entry.epoch = headroom_epoch_;
+        entry.safe = std::max<ResourceQuantity>(entry.safe - quantity, 0);
+        entry.unsafe_from -= quantity;
     }
+}
 
-    for (auto& [id, agent] : agents_) {
-        input.allocation[id] = agent.current_allocation();
-        input.max_need[id] = agent.max_needs();
+void ResourceManager::invalidate_headroom() {
+    ++headroom_epoch_;
+}
+
+void ResourceManager::commit_release(Agent& agent, Resource& res,
+                                     ResourceQuantity quantity) {
+    // Caller must hold exclusive state_mutex_
+    agent.deallocate(res.id(), quantity);
+    res.deallocate(quantity);
+    sync_safety_cell(agent, res);
+    {
+        PublishScope publish(*this);
+        publish.agent(agent);
+        publish.resource(res);
+        publish.released();
     }
+    ++headroom_releases_;
+}
 
-    return input;
+ResourceQuantity ResourceManager::refill(Resource& res, ReplenishState& state,
+                                         Timestamp now) {
+    ResourceQuantity due = 0;
+    if (res.replenish_policy() == ReplenishPolicy::SlidingWindow) {
+        while (!state.window.empty() && state.window.front().first <= now) {
+            due += state.window.front().second;
+            state.window.pop_front();
+        }
+    } else if (res.consumed() > 0) {
+        // total_capacity units accrue per replenish interval
+        std::chrono::duration<double> elapsed = now - state.last_refill;
+        std::chrono::duration<double> interval = *res.replenish_interval();
+        state.credit += elapsed / interval * static_cast<double>(res.total_capacity());
+        state.last_refill = now;
+        due = static_cast<ResourceQuantity>(state.credit);
+        state.credit -= static_cast<double>(due);
+    }
+
+    due = std::min(due, res.consumed());
+    if (due > 0) res.replenish(due);
+    if (res.consumed() == 0) {
+        // Full: a bucket accrues nothing more until the next consumption
+        state.window.clear();
+        state.credit = 0.0;
+    }
+    return due;
+}
+
+void ResourceManager::arm_replenish(const Resource& res, ReplenishState& state) {
+    if (state.armed_for || res.consumed() == 0) return;
+
+    Timestamp due;
+    if (res.replenish_policy() == ReplenishPolicy::SlidingWindow) {
+        if (state.window.empty()) return;
+        due = state.window.front().first;
+    } else {
+        if (res.total_capacity() <= 0) return;
+        // When the credit reaches a whole unit
+        std::chrono::duration<double> per_unit =
+            std::chrono::duration<double>(*res.replenish_interval()) /
+            static_cast<double>(res.total_capacity());
+        due = state.last_refill + std::chrono::ceil<Duration>(per_unit * (1.0 - state.credit));
+    }
+    state.armed_for = due;
+    replenish_wheel_.schedule(due, res.id());
+    publish_next_refill();
+}
+
+void ResourceManager::publish_next_refill() {
+    auto next = replenish_wheel_.next_expiry();
+    next_refill_.store(next ? next->time_since_epoch().count() : NO_REFILL,
+                       std::memory_order_relaxed);
+}
+
+std::optional<Timestamp> ResourceManager::next_replenish() const {
+    auto next = next_refill_.load(std::memory_order_relaxed);
+    if (next == NO_REFILL) return std::nullopt;
+    return Timestamp(Duration(next));
+}
+
+void ResourceManager::sync_safety_cell(const Agent& agent, const Resource& res) {
+    // Mirror the authoritative Agent/Resource values (which clamp on release)
+    std::size_t row = safety_matrix_.agent_slot(agent.id());
+    std::size_t col = safety_matrix_.resource_slot(res.id());
+    auto& alloc = agent.current_allocation();
+    auto alloc_it = alloc.find(res.id());
+    safety_matrix_.set_allocation(row, col, (alloc_it != alloc.end()) ? alloc_it->second : 0);
+    safety_matrix_.set_available(col, safety_available(res));
+}
+
+SafetyCheckResult ResourceManager::check_grant(AgentId agent_id,
+                                               ResourceTypeId resource_type,
+                                               ResourceQuantity quantity) {
+    // Caller must hold exclusive state_mutex_
+    std::size_t row = safety_matrix_.agent_slot(agent_id);
+    std::size_t col = safety_matrix_.resource_slot(resource_type);
+    if (!config_.cache_grant_headroom || row == SafetyMatrix::npos ||
+        col == SafetyMatrix::npos) {
+        return verify_grant(agent_id, resource_type, quantity);
+    }
+    // Headroom is tracked within the declared claim; anything beyond it is
+    // checked directly
+    if (safety_matrix_.max_need(row, col) > 0 && quantity > safety_matrix_.need(row, col)) {
+        return verify_grant(agent_id, resource_type, quantity);
+    }
+
+    auto& entry = headroom_entry(row, col);
+    SafetyCheckResult result;
+    if (quantity <= entry.safe) {
+        headroom_hits_.fetch_add(1, std::memory_order_relaxed);
+        result.is_safe = true;
+        result.reason.assign("Within safe grant headroom");
+        return result;
+    }
+    if (entry.unsafe_stamp == headroom_releases_ && quantity >= entry.unsafe_from) {
+        result.is_safe = false;
+        result.reason = "A grant of " + std::to_string(entry.unsafe_from) +
+                        " or more is already known to be unsafe";
+        return result;
+    }
+    // Between the bounds: one check, whose verdict tightens them
+    result = probe_headroom(entry, agent_id, resource_type, quantity);
+    if (result.is_safe && config_.reuse_safe_sequence) {
+        // Most agents can take their whole remaining need. Replaying the safe
+        // sequence just found is one linear pass, so try that for the next
+        // request's sake, but never search for it.
+        ResourceQuantity whole = safety_matrix_.available(col);
+        if (safety_matrix_.max_need(row, col) > 0) {
+            whole = std::min(whole, safety_matrix_.need(row, col));
+        }
+        if (whole > entry.safe &&
+            safety_checker_.replay_hypothetical(safety_matrix_, agent_id, resource_type,
+                                                whole, safe_sequence_)) {
+            entry.safe = whole;
+        }
+    }
+    return result;
+}
+
+ResourceManager::HeadroomEntry& ResourceManager::headroom_entry(std::size_t row,
+                                                                std::size_t col) {
+    std::size_t cells = safety_matrix_.row_count() * safety_matrix_.stride();
+    if (headroom_.size() < cells) headroom_.resize(cells);
+    auto& entry = headroom_[row * safety_matrix_.stride() + col];
+    if (entry.epoch != headroom_epoch_) {
+        // Granting nothing is always safe: the current state is
+        entry = HeadroomEntry{};
+        entry.epoch = headroom_epoch_;
+    }
+    return entry;
+}
+
+SafetyCheckResult ResourceManager::probe_headroom(HeadroomEntry& entry, AgentId agent_id,
+                                                  ResourceTypeId resource_type,
+                                                  ResourceQuantity quantity) {
+    auto result = verify_grant(agent_id, resource_type, quantity);
+    if (result.is_safe) {
+        entry.safe = std::max(entry.safe, quantity);
+    } else if (entry.unsafe_stamp != headroom_releases_ || quantity < entry.unsafe_from) {
+        entry.unsafe_from = quantity;
+        entry.unsafe_stamp = headroom_releases_;
+    }
+    return result;
+}
+
+ResourceQuantity ResourceManager::largest_safe_grant(AgentId agent_id,
+                                                     ResourceTypeId resource_type,
+                                                     ResourceQuantity min_quantity,
+                                                     ResourceQuantity max_quantity) {
+    // Caller must hold exclusive state_mutex_
+    std::size_t row = safety_matrix_.agent_slot(agent_id);
+    std::size_t col = safety_matrix_.resource_slot(resource_type);
+    if (row == SafetyMatrix::npos || col == SafetyMatrix::npos) return 0;
+
+    // The matrix counts consumed units as available; a grant needs them back
+    auto res_it = resources_.find(resource_type);
+    if (res_it == resources_.end()) return 0;
+    ResourceQuantity cap = std::min(max_quantity, res_it->second.available());
+    if (safety_matrix_.max_need(row, col) > 0) {
+        cap = std::min(cap, safety_matrix_.need(row, col));
+    }
+    if (cap < min_quantity) return 0;
+
+    // Without the table the bounds only last for this call
+    HeadroomEntry scratch;
+    auto& entry = config_.cache_grant_headroom ? headroom_entry(row, col) : scratch;
+    if (cap <= entry.safe) {
+        headroom_hits_.fetch_add(1, std::memory_order_relaxed);
+        return cap;
+    }
+    ResourceQuantity hi = cap;
+    if (entry.unsafe_stamp == headroom_releases_) hi = std::min(hi, entry.unsafe_from - 1);
+    if (hi < min_quantity) return 0;
+
+    // Safety is monotone in the grant size, so bisect between a known-safe
+    // and a known-unsafe quantity
+    ResourceQuantity lo = entry.safe;
+    if (lo < min_quantity) {
+        if (!probe_headroom(entry, agent_id, resource_type, min_quantity).is_safe) return 0;
+        lo = min_quantity;
+    }
+    if (hi == lo || probe_headroom(entry, agent_id, resource_type, hi).is_safe) return hi;
+    while (hi - lo > 1) {
+        ResourceQuantity mid = lo + (hi - lo) / 2;
+        if (probe_headroom(entry, agent_id, resource_type, mid).is_safe) lo = mid;
+        else hi = mid;
+    }
+    return lo;
+}
+
+SafetyCheckResult ResourceManager::verify_grant(AgentId agent_id,
+                                                ResourceTypeId resource_type,
+                                                ResourceQuantity quantity) {
+    // Caller must hold exclusive state_mutex_
+    SafetyCheckResult result;
+    if (config_.reuse_safe_sequence) {
+        if (!safe_sequence_.empty() &&
+            safety_checker_.replay_hypothetical(safety_matrix_, agent_id, resource_type,
+                                                quantity, safe_sequence_)) {
+            safety_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+            result.is_safe = true;
+            result.safe_sequence = safe_sequence_;
+            result.reason.assign("Safe state found (cached sequence)");
+            return result;
+        }
+        safety_cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    safety_checker_.check_hypothetical_in_place(safety_matrix_, agent_id, resource_type,
+                                                quantity, result);
+    if (result.is_safe) safe_sequence_ = result.safe_sequence;
+    return result;
+}
+
+SystemSnapshot ResourceManager::read_published() const {
+    SystemSnapshot snap;
+    auto index = std::atomic_load_explicit(&published_, std::memory_order_acquire);
+    for (auto& [id, c] : index->resources) {
+        auto res = std::atomic_load_explicit(&c->value, std::memory_order_acquire);
+        snap.total_resources[id] = res->total_capacity();
+        snap.available_resources[id] = res->available();
+    }
+    snap.agents.reserve(index->agents.size());
+    for (auto& [id, c] : index->agents) {
+        auto agent = std::atomic_load_explicit(&c->value, std::memory_order_acquire);
+        AgentAllocationSnapshot as;
+        as.agent_id = id;
+        as.name = agent->name();
+        as.priority = agent->priority();
+        as.state = agent->state();
+        as.allocation = agent->current_allocation();
+        as.max_claim = agent->max_needs();
+        snap.agents.push_back(std::move(as));
+    }
+    snap.is_safe = published_safe_.load(std::memory_order_relaxed);
+    return snap;
+}
+
+SystemSnapshot ResourceManager::published_snapshot() const {
+    // A snapshot spans many cells, so it retries if a writer published
+    // meanwhile. Under sustained writes it holds them off for one read
+    // instead; they publish before releasing the lock.
+    constexpr int kAttempts = 4;
+    for (int attempt = 0; attempt < kAttempts; ++attempt) {
+        auto seq = publish_seq_.load(std::memory_order_acquire);
+        if (seq & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        SystemSnapshot snap = read_published();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (publish_seq_.load(std::memory_order_relaxed) == seq) return snap;
+    }
+    std::shared_lock lock(state_mutex_);
+    return read_published();
+}
+
+void ResourceManager::wake_waiters(ResourceTypeId id) {
+    auto it = waiters_.find(id);
+    if (it != waiters_.end()) {
+        for (WaitSlot* slot : it->second) {
+            bool fits = std::all_of(slot->wants.begin(), slot->wants.end(),
+                [this](const auto& want) {
+                    auto res_it = resources_.find(want.first);
+                    return res_it == resources_.end() ||
+                           res_it->second.available() >= want.second;
+                });
+            if (fits) slot->signal();
+        }
+    }
+    for (WaitSlot* slot : unsafe_waiters_) slot->signal();
+}
+
+void ResourceManager::wake_all_waiters() {
+    for (auto& [rt, list] : waiters_) {
+        for (WaitSlot* slot : list) slot->signal();
+    }
+}
+
+void ResourceManager::mark_resource_dirty(ResourceTypeId id) {
+    {
+        std::lock_guard lock(pending_work_mutex_);
+        dirty_resources_.insert(id);
+    }
+    processor_cv_.notify_one();
+}
+
+void ResourceManager::mark_resource_freed(ResourceTypeId id) {
+    {
+        std::lock_guard lock(pending_work_mutex_);
+        dirty_resources_.insert(id);
+        state_released_ = true;
+    }
+    processor_cv_.notify_one();
+}
+
+void ResourceManager::mark_rescan_all() {
+    {
+        std::lock_guard lock(pending_work_mutex_);
+        rescan_all_ = true;
+    }
+    processor_cv_.notify_one();
+}
+
+bool ResourceManager::has_pending_work() const {
+    return rescan_all_ || state_released_ || !dirty_resources_.empty();
+}
+
+std::vector<ResourceRequest> ResourceManager::collect_pending_work() {
+    std::unordered_set<ResourceTypeId> dirty;
+    bool released = false;
+    bool rescan_all = false;
+    {
+        std::lock_guard lock(pending_work_mutex_);
+        dirty.swap(dirty_resources_);
+        std::swap(released, state_released_);
+        std::swap(rescan_all, rescan_all_);
+    }
+
+    if (rescan_all) {
+        unsafe_blocked_.clear();
+        return request_queue_.get_all_pending();
+    }
+
+    // Waiters on each released resource, plus anything refused as unsafe
+    std::vector<ResourceRequest> work;
+    std::unordered_set<RequestId> seen;
+    for (auto rt : dirty) {
+        for (auto& req : request_queue_.get_pending_for_resource(rt)) {
+            // A multi-resource request is listed under each of its parts
+            if (seen.insert(req.id).second) work.push_back(std::move(req));
+        }
+    }
+    if (released) {
+        for (auto it = unsafe_blocked_.begin(); it != unsafe_blocked_.end();) {
+            if (seen.count(*it)) {
+                ++it;
+                continue;
+            }
+            auto req = request_queue_.find(*it);
+            if (!req) {
+                it = unsafe_blocked_.erase(it);  // cancelled or expired meanwhile
+                continue;
+            }
+            work.push_back(std::move(*req));
+            ++it;
+        }
+    }
+    return work;
+}
+
+void ResourceManager::replenish_due() {
+    auto due_at = next_replenish();
+    if (!due_at || Clock::now() < *due_at) return;
+
+    std::vector<std::pair<ResourceTypeId, ResourceQuantity>> refilled;
+    {
+        std::unique_lock lock(state_mutex_);
+        auto now = Clock::now();
+        for (auto id : replenish_wheel_.advance(now)) {
+            auto res_it = resources_.find(id);
+            auto state_it = replenish_.find(id);
+            if (res_it == resources_.end() || state_it == replenish_.end()) continue;
+
+            // A timer left over from an earlier registration of the same id
+            // must not disarm the live one
+            auto& state = state_it->second;
+            if (state.armed_for && *state.armed_for <= now) state.armed_for.reset();
+            ResourceQuantity qty = refill(res_it->second, state, now);
+            arm_replenish(res_it->second, state);
+            if (qty > 0) {
+                // Consumed units already counted as available to the safety
+                // matrix, so only the resource itself changes
+                PublishScope(*this).resource(res_it->second);
+                wake_waiters(id);
+                refilled.emplace_back(id, qty);
+            }
+        }
+        publish_next_refill();
+    }
+
+    for (auto& [id, qty] : refilled) {
+        mark_resource_dirty(id);
+        emit_event(EventType::ResourcesReplenished, "Consumed units replenished",
+                   std::nullopt, id, std::nullopt, qty);
+    }
 }
 
 void ResourceManager::process_queue_loop() {
     while (running_.load()) {
-        // Process callback-based requests from the queue
-        try_grant_pending_requests();
+        // Return consumed units that are due, then retry what they unblock
+        replenish_due();
 
-        // Expire timed-out requests
+        // Expire timed-out requests first, so none is granted past its
+        // deadline (requests parked before start() may be long overdue)
         if (config_.enable_timeout_expiration) {
             auto expired = request_queue_.expire_timed_out();
             for (auto req_id : expired) {
@@ -635,84 +1826,210 @@ void ResourceManager::process_queue_loop() {
             }
         }
 
-        // Sleep briefly
-        std::unique_lock lock(state_mutex_);
-        release_cv_.wait_for(lock, config_.processor_poll_interval);
+        // Process callback-based requests from the queue
+        try_grant_pending_requests();
+
+        // Sleep until there is something to re-examine, a request expires or
+        // the oldest queued request crosses the starvation threshold
+        std::optional<Timestamp> deadline;
+        if (config_.enable_timeout_expiration) {
+            deadline = request_queue_.next_deadline();
+        }
+        if (auto due = detect_starvation(); due && (!deadline || *due < *deadline)) {
+            deadline = due;
+        }
+        if (auto due = next_replenish(); due && (!deadline || *due < *deadline)) {
+            deadline = due;
+        }
+        std::unique_lock lock(pending_work_mutex_);
+        auto wake = [this] { return !running_.load() || has_pending_work(); };
+        if (deadline) {
+            processor_cv_.wait_until(lock, *deadline, wake);
+        } else {
+            processor_cv_.wait(lock, wake);
+        }
+    }
+}
+
+std::optional<Timestamp> ResourceManager::detect_starvation() {
+    const Duration threshold = config_.starvation_threshold;
+    const Priority boost = config_.starvation_priority_boost;
+    if (threshold <= Duration::zero()) return std::nullopt;
+    if (boost == 0 && !wants_event(EventType::RequestStarved)) return std::nullopt;
+
+    // The queue keeps an index by submission time, so this only touches
+    // requests that crossed the threshold since the last pass
+    auto now = Clock::now();
+    for (auto& req : request_queue_.take_starved(now - threshold)) {
+        if (boost != 0) {
+            if (auto boosted = request_queue_.boost_priority(req.id, boost)) req.priority = *boosted;
+        }
+        double age_us = std::chrono::duration<double, std::micro>(now - req.submitted_at).count();
+        emit_event(EventType::RequestStarved, "Queued request exceeded starvation threshold",
+                   req.agent_id, req.resource_type, req.id, req.quantity,
+                   std::nullopt, age_us, req.priority);
+    }
+
+    auto oldest = request_queue_.oldest_unreported();
+    if (!oldest) return std::nullopt;
+    return *oldest + threshold;
+}
+
+void ResourceManager::snapshot_loop() {
+    // Snapshots come from the published state without the state lock, and
+    // are only copied again after a writer has published; between changes
+    // only the timestamp and queue length are refreshed
+    std::optional<std::uint64_t> version;
+    SystemSnapshot snap;
+    auto next = Clock::now() + config_.snapshot_interval;
+
+    std::unique_lock lock(snapshot_mutex_);
+    while (running_.load()) {
+        if (snapshot_cv_.wait_until(lock, next, [this] { return !running_.load(); })) break;
+        // Fixed rate, but a slow monitor skips ticks rather than bunching them
+        next += config_.snapshot_interval;
+        if (auto now = Clock::now(); next < now) next = now + config_.snapshot_interval;
+        lock.unlock();
+
+        auto monitor = monitor_;
+        if (monitor) {
+            auto seq = publish_seq_.load(std::memory_order_acquire);
+            if (seq != version || (seq & 1)) {
+                snap = published_snapshot();
+                version = seq;
+            }
+            snap.timestamp = Clock::now();
+            snap.pending_requests = request_queue_.size();
+            monitor->on_snapshot(snap);
+        }
+        lock.lock();
     }
 }
 
 void ResourceManager::try_grant_pending_requests() {
-    auto pending = request_queue_.get_all_pending();
+    auto pending = collect_pending_work();
     if (pending.empty()) return;
 
-    // Apply scheduling policy
-    auto snapshot = get_snapshot();
-    auto ordered = scheduling_policy_->prioritize(pending, snapshot);
+    // Apply scheduling policy; only build a snapshot if the policy reads it
+    auto ordered = scheduling_policy_->uses_snapshot()
+        ? scheduling_policy_->prioritize(pending, get_snapshot())
+        : scheduling_policy_->prioritize(pending, SystemSnapshot{});
 
     for (auto& req : ordered) {
+        if (req.is_bundle()) {
+            try_grant_bundle(req);
+            continue;
+        }
         std::unique_lock lock(state_mutex_);
 
         auto res_it = resources_.find(req.resource_type);
         auto agent_it = agents_.find(req.agent_id);
         if (res_it == resources_.end() || agent_it == agents_.end()) {
+            lock.unlock();
             request_queue_.cancel(req.id);
+            unsafe_blocked_.erase(req.id);
             continue;
         }
 
-        if (res_it->second.available() >= req.quantity) {
-            auto input = build_safety_input();
-            auto t0 = std::chrono::steady_clock::now();
-            auto result = safety_checker_.check_hypothetical(
-                input, req.agent_id, req.resource_type, req.quantity);
-            auto t1 = std::chrono::steady_clock::now();
-            double dur_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
-
-            emit_event(EventType::SafetyCheckPerformed, result.reason,
-                       req.agent_id, req.resource_type, req.id, req.quantity,
-                       result.is_safe, dur_us);
+        // Short on its own resource: woken again when that resource is released
+        unsafe_blocked_.erase(req.id);
 
-            if (result.is_safe) {
-                res_it->second.allocate(req.quantity);
-                agent_it->second.allocate(req.resource_type, req.quantity);
+        if (res_it->second.available() >= req.quantity) {
+            SpanTimer timer(wants_duration(EventType::SafetyCheckPerformed));
+            auto result = check_grant(req.agent_id, req.resource_type, req.quantity);
+            auto check_event = make_event(EventType::SafetyCheckPerformed, result.reason,
+                                          req.agent_id, req.resource_type, req.id, req.quantity,
+                                          result.is_safe, timer.elapsed_us(), req.priority);
+
+            if (!result.is_safe) {
+                unsafe_blocked_.insert(req.id);
                 lock.unlock();
+                emit_event(check_event);
+                continue;
+            }
+
+            // Claim the request before granting; it may have been cancelled
+            // or expired since it was collected
+            bool claimed = request_queue_.remove(req.id);
+            if (claimed) commit_allocation(agent_it->second, res_it->second, req.quantity);
+            lock.unlock();
+            emit_event(check_event);
+            if (claimed) {
 
-                // Remove from queue and notify callback
-                request_queue_.cancel(req.id);  // Remove from queue
                 if (req.callback) {
-                    req.callback(req.id, RequestStatus::Granted);
+                    executor_->execute([cb = std::move(req.callback), id = req.id] {
+                        cb(id, RequestStatus::Granted);
+                    });
+                }
+                std::optional<double> waited_us;
+                if (wants_duration(EventType::RequestGranted)) {
+                    waited_us = std::chrono::duration<double, std::micro>(
+                        Clock::now() - req.submitted_at).count();
                 }
                 emit_event(EventType::RequestGranted, "Queue request granted",
-                           req.agent_id, req.resource_type, req.id, req.quantity);
+                           req.agent_id, req.resource_type, req.id, req.quantity,
+                           std::nullopt, waited_us, req.priority);
             }
         }
     }
 }
 
-bool ResourceManager::try_grant_single(AgentId agent_id, ResourceTypeId resource_type,
-                                         ResourceQuantity quantity) {
-    // Caller must hold exclusive state_mutex_
-    auto res_it = resources_.find(resource_type);
-    auto agent_it = agents_.find(agent_id);
-    if (res_it == resources_.end() || agent_it == agents_.end()) return false;
+void ResourceManager::try_grant_bundle(ResourceRequest& req) {
+    std::unique_lock lock(state_mutex_);
 
-    if (res_it->second.available() < quantity) return false;
+    auto agent_it = agents_.find(req.agent_id);
+    bool known = agent_it != agents_.end() &&
+        std::all_of(req.bundle.begin(), req.bundle.end(), [this](const ResourceDemand& part) {
+            return resources_.count(part.resource_type) > 0;
+        });
+    if (!known) {
+        lock.unlock();
+        request_queue_.cancel(req.id);
+        unsafe_blocked_.erase(req.id);
+        return;
+    }
 
-    auto input = build_safety_input();
-    auto t0 = std::chrono::steady_clock::now();
-    auto result = safety_checker_.check_hypothetical(input, agent_id, resource_type, quantity);
-    auto t1 = std::chrono::steady_clock::now();
-    double dur_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    // Short on one of its parts: woken again when that part is released
+    unsafe_blocked_.erase(req.id);
+    SpanTimer timer(wants_duration(EventType::SafetyCheckPerformed));
+    auto checked = check_bundle(req.agent_id, req.bundle);
+    if (!checked) return;
+
+    auto check_event = make_event(EventType::SafetyCheckPerformed, checked->reason,
+                                  req.agent_id, std::nullopt, req.id, std::nullopt,
+                                  checked->is_safe, timer.elapsed_us(), req.priority);
+    if (!checked->is_safe) {
+        unsafe_blocked_.insert(req.id);
+        lock.unlock();
+        emit_event(check_event);
+        return;
+    }
 
-    emit_event(EventType::SafetyCheckPerformed, result.reason,
-               agent_id, resource_type, std::nullopt, quantity,
-               result.is_safe, dur_us);
+    // Claim the request before granting; it may have been cancelled or
+    // expired since it was collected
+    bool claimed = request_queue_.remove(req.id);
+    if (claimed) {
+        for (auto& part : req.bundle) {
+            commit_allocation(agent_it->second, resources_.at(part.resource_type), part.quantity);
+        }
+    }
+    lock.unlock();
+    emit_event(check_event);
+    if (!claimed) return;
 
-    if (result.is_safe) {
-        res_it->second.allocate(quantity);
-        agent_it->second.allocate(resource_type, quantity);
-        return true;
+    if (req.callback) {
+        executor_->execute([cb = std::move(req.callback), id = req.id] {
+            cb(id, RequestStatus::Granted);
+        });
     }
-    return false;
+    std::optional<double> waited_us;
+    if (wants_duration(EventType::RequestGranted)) {
+        waited_us = std::chrono::duration<double, std::micro>(
+            Clock::now() - req.submitted_at).count();
+    }
+    emit_event(EventType::RequestGranted, "Queued batch granted",
+               req.agent_id, std::nullopt, req.id, std::nullopt,
+               std::nullopt, waited_us, req.priority);
 }
 
 // ==================== Progress Monitoring ====================
@@ -765,8 +2082,15 @@ std::optional<std::vector<AgentId>> ResourceManager::find_delegation_cycle() con
 
 void ResourceManager::set_agent_demand_mode(AgentId id, DemandMode mode) {
     demand_estimator_.set_agent_demand_mode(id, mode);
-    emit_event(EventType::AdaptiveDemandModeChanged,
-               std::string("Demand mode changed to ") + to_string(mode), id);
+    {
+        // Blocked adaptive requests are judged against the estimates
+        std::unique_lock lock(state_mutex_);
+        wake_all_waiters();
+    }
+    if (wants_event(EventType::AdaptiveDemandModeChanged)) {
+        emit_event(EventType::AdaptiveDemandModeChanged,
+                   std::string("Demand mode changed to ") + to_string(mode), id);
+    }
 }
 
 ProbabilisticSafetyResult ResourceManager::check_safety_probabilistic(double confidence) const {
@@ -818,100 +2142,104 @@ RequestStatus ResourceManager::request_resources_adaptive(
         }
     }
 
+    SpanTimer wait_timer(wants_duration(EventType::RequestGranted));
     emit_event(EventType::RequestSubmitted, "Adaptive request submitted",
                agent_id, resource_type, std::nullopt, quantity);
 
     demand_estimator_.record_request(agent_id, resource_type, quantity);
 
     // Try to grant immediately using adaptive safety check
+    std::optional<MonitorEvent> check_event;
+    std::optional<MonitorEvent> unsafe_event;
     {
         std::unique_lock lock(state_mutex_);
         auto& res = resources_.at(resource_type);
 
         if (res.available() >= quantity) {
+            Priority priority = agents_.at(agent_id).priority();
             auto input = build_adaptive_safety_input(config_.adaptive.default_confidence_level);
-            auto t0 = std::chrono::steady_clock::now();
+            SpanTimer timer(wants_duration(EventType::ProbabilisticSafetyCheck));
             auto result = safety_checker_.check_hypothetical_probabilistic(
                 input, agent_id, resource_type, quantity,
                 config_.adaptive.default_confidence_level);
-            auto t1 = std::chrono::steady_clock::now();
-            double dur_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
 
-            emit_event(EventType::ProbabilisticSafetyCheck, result.reason,
-                       agent_id, resource_type, std::nullopt, quantity,
-                       result.is_safe, dur_us);
+            check_event = make_event(EventType::ProbabilisticSafetyCheck, result.reason,
+                                     agent_id, resource_type, std::nullopt, quantity,
+                                     result.is_safe, timer.elapsed_us(), priority);
 
             if (result.is_safe) {
-                res.allocate(quantity);
-                agents_.at(agent_id).allocate(resource_type, quantity);
+                commit_allocation(agents_.at(agent_id), res, quantity, /*checked=*/false);
                 auto alloc = agents_.at(agent_id).current_allocation();
                 auto a_it = alloc.find(resource_type);
                 ResourceQuantity level = (a_it != alloc.end()) ? a_it->second : 0;
                 lock.unlock();
+                emit_event(check_event);
                 demand_estimator_.record_allocation_level(agent_id, resource_type, level);
                 emit_event(EventType::RequestGranted, "Adaptive request granted immediately",
-                           agent_id, resource_type, std::nullopt, quantity);
+                           agent_id, resource_type, std::nullopt, quantity,
+                           std::nullopt, wait_timer.elapsed_us(), priority);
                 return RequestStatus::Granted;
-            } else {
-                emit_event(EventType::UnsafeStateDetected,
-                          "Adaptive: would create unsafe state", agent_id, resource_type);
             }
+            unsafe_event = make_event(EventType::UnsafeStateDetected,
+                                      "Adaptive: would create unsafe state",
+                                      agent_id, resource_type);
         }
     }
+    emit_event(check_event);
+    emit_event(unsafe_event);
 
     // Wait with timeout
     Duration wait_timeout = timeout.value_or(config_.default_request_timeout);
     auto deadline = Clock::now() + wait_timeout;
 
+    WaiterScope waiter(*this, agent_id, {{resource_type, quantity}});
     while (Clock::now() < deadline) {
-        {
-            std::unique_lock lock(state_mutex_);
-
-            auto res_it = resources_.find(resource_type);
-            if (res_it == resources_.end()) return RequestStatus::Denied;
-            auto agent_it = agents_.find(agent_id);
-            if (agent_it == agents_.end()) return RequestStatus::Denied;
-
-            if (res_it->second.available() >= quantity) {
-                auto input = build_adaptive_safety_input(config_.adaptive.default_confidence_level);
-                auto t0 = std::chrono::steady_clock::now();
-                auto result = safety_checker_.check_hypothetical_probabilistic(
-                    input, agent_id, resource_type, quantity,
-                    config_.adaptive.default_confidence_level);
-                auto t1 = std::chrono::steady_clock::now();
-                double dur_us = std::chrono::duration<double, std::micro>(t1 - t0).count();
-
-                emit_event(EventType::ProbabilisticSafetyCheck, result.reason,
-                           agent_id, resource_type, std::nullopt, quantity,
-                           result.is_safe, dur_us);
-
-                if (result.is_safe) {
-                    res_it->second.allocate(quantity);
-                    agent_it->second.allocate(resource_type, quantity);
-                    auto alloc = agent_it->second.current_allocation();
-                    auto a_it = alloc.find(resource_type);
-                    ResourceQuantity level = (a_it != alloc.end()) ? a_it->second : 0;
-                    lock.unlock();
-                    demand_estimator_.record_allocation_level(agent_id, resource_type, level);
-                    emit_event(EventType::RequestGranted, "Adaptive request granted after waiting",
-                               agent_id, resource_type, std::nullopt, quantity);
-                    return RequestStatus::Granted;
-                }
+        auto res_it = resources_.find(resource_type);
+        if (res_it == resources_.end()) return RequestStatus::Denied;
+        auto agent_it = agents_.find(agent_id);
+        if (agent_it == agents_.end()) return RequestStatus::Denied;
 
-                if (!running_.load()) {
-                    lock.unlock();
-                    emit_event(EventType::RequestDenied,
-                              "Adaptive: unsafe state and no processor running",
-                              agent_id, resource_type, std::nullopt, quantity);
-                    return RequestStatus::Denied;
-                }
+        bool unsafe = false;
+        if (res_it->second.available() >= quantity) {
+            Priority priority = agent_it->second.priority();
+            auto input = build_adaptive_safety_input(config_.adaptive.default_confidence_level);
+            SpanTimer timer(wants_duration(EventType::ProbabilisticSafetyCheck));
+            auto result = safety_checker_.check_hypothetical_probabilistic(
+                input, agent_id, resource_type, quantity,
+                config_.adaptive.default_confidence_level);
+
+            waiter.defer(make_event(EventType::ProbabilisticSafetyCheck, result.reason,
+                                    agent_id, resource_type, std::nullopt, quantity,
+                                    result.is_safe, timer.elapsed_us(), priority));
+
+            if (result.is_safe) {
+                commit_allocation(agent_it->second, res_it->second, quantity,
+                                  /*checked=*/false);
+                auto alloc = agent_it->second.current_allocation();
+                auto a_it = alloc.find(resource_type);
+                ResourceQuantity level = (a_it != alloc.end()) ? a_it->second : 0;
+                waiter.unlock();
+                demand_estimator_.record_allocation_level(agent_id, resource_type, level);
+                emit_event(EventType::RequestGranted, "Adaptive request granted after waiting",
+                           agent_id, resource_type, std::nullopt, quantity,
+                           std::nullopt, wait_timer.elapsed_us(), priority);
+                return RequestStatus::Granted;
             }
 
-            auto remaining = deadline - Clock::now();
-            if (remaining <= Duration::zero()) break;
-            release_cv_.wait_for(lock, std::min(remaining, config_.processor_poll_interval));
+            if (!running_.load()) {
+                waiter.unlock();
+                emit_event(EventType::RequestDenied,
+                          "Adaptive: unsafe state and no processor running",
+                          agent_id, resource_type, std::nullopt, quantity);
+                return RequestStatus::Denied;
+            }
+            unsafe = true;
         }
+
+        waiter.set_unsafe(unsafe);
+        if (!waiter.wait(deadline)) break;
     }
+    waiter.unlock();
 
     emit_event(EventType::RequestTimedOut, "Adaptive request timed out",
                agent_id, resource_type, std::nullopt, quantity);
@@ -926,7 +2254,7 @@ SafetyCheckInput ResourceManager::build_adaptive_safety_input(double confidence_
 
     for (auto& [id, res] : resources_) {
         input.total[id] = res.total_capacity();
-        input.available[id] = res.available();
+        input.available[id] = safety_available(res);
     }
 
     // Get estimated max needs from DemandEstimator
@@ -987,27 +2315,45 @@ SafetyCheckInput ResourceManager::build_adaptive_safety_input(double confidence_
 
 // ==================== Event Emission ====================
 
-void ResourceManager::emit_event(EventType type, const std::string& message,
+void ResourceManager::emit_event(EventType type, std::string_view message,
                                    std::optional<AgentId> agent_id,
                                    std::optional<ResourceTypeId> resource_type,
                                    std::optional<RequestId> request_id,
                                    std::optional<ResourceQuantity> quantity,
                                    std::optional<bool> safety_result,
-                                   std::optional<double> duration_us) {
-    if (!monitor_) return;
+                                   std::optional<double> duration_us,
+                                   std::optional<Priority> priority) {
+    emit_event(make_event(type, message, agent_id, resource_type, request_id,
+                          quantity, safety_result, duration_us, priority));
+}
+
+std::optional<MonitorEvent> ResourceManager::make_event(
+    EventType type, std::string_view message,
+    std::optional<AgentId> agent_id,
+    std::optional<ResourceTypeId> resource_type,
+    std::optional<RequestId> request_id,
+    std::optional<ResourceQuantity> quantity,
+    std::optional<bool> safety_result,
+    std::optional<double> duration_us,
+    std::optional<Priority> priority) const {
+    if (!monitor_ || !wants_event(type)) return std::nullopt;
 
     MonitorEvent event;
     event.type = type;
     event.timestamp = Clock::now();
-    event.message = message;
+    event.message.assign(message);
     event.agent_id = agent_id;
     event.resource_type = resource_type;
     event.request_id = request_id;
     event.quantity = quantity;
     event.safety_result = safety_result;
     event.duration_us = duration_us;
+    event.priority = priority;
+    return event;
+}
 
-    monitor_->on_event(event);
+void ResourceManager::emit_event(const std::optional<MonitorEvent>& event) {
+    if (event && monitor_) monitor_->on_event(*event);
 }
 
 } // namespace agentguard
@@ -1,8 +1,9 @@
 #include "agentguard/safety_checker.hpp"
+#include "safety_kernels.hpp"
 
 #include <algorithm>
-#include <numeric>
 #include <unordered_set>
+#include <utility>
 
 namespace agentguard {
 
@@ -47,163 +48,423 @@ ResourceQuantity get_remaining_need(
     return max_val - alloc_val;
 }
 
-// Get current allocation for an agent on a specific resource
-ResourceQuantity get_allocation(
-    const SafetyCheckInput& input,
-    AgentId agent,
-    ResourceTypeId rt)
+// Apply a hypothetical grant, adding slots the state does not know yet
+// (mirrors how the map-based form default-inserts missing entries)
+void apply_grant(SafetyMatrix& state, AgentId agent,
+                 ResourceTypeId rt, ResourceQuantity quantity)
 {
-    auto alloc_it = input.allocation.find(agent);
-    if (alloc_it != input.allocation.end()) {
-        auto rt_it = alloc_it->second.find(rt);
-        if (rt_it != alloc_it->second.end()) {
-            return rt_it->second;
-        }
-    }
-    return 0;
+    std::size_t col = state.add_resource(rt);
+    std::size_t row = state.add_agent(agent);
+    state.allocate(row, col, quantity);
 }
 
-// Check if an agent's remaining needs can be satisfied with available resources
-bool can_finish(
-    const SafetyCheckInput& input,
-    AgentId agent,
-    const std::unordered_map<ResourceTypeId, ResourceQuantity>& work,
-    const std::vector<ResourceTypeId>& resource_types)
-{
-    for (auto rt : resource_types) {
-        ResourceQuantity need = get_remaining_need(input, agent, rt);
-        auto avail_it = work.find(rt);
-        ResourceQuantity avail = (avail_it != work.end()) ? avail_it->second : 0;
-        if (need > avail) {
-            return false;
+// Applies a hypothetical grant to an existing cell and undoes it on scope exit
+class ScopedGrant {
+public:
+    ScopedGrant(SafetyMatrix& state, std::size_t row, std::size_t col,
+                ResourceQuantity quantity)
+        : state_(state), row_(row), col_(col), quantity_(quantity)
+    {
+        state_.allocate(row_, col_, quantity_);
+    }
+    ~ScopedGrant() { state_.allocate(row_, col_, -quantity_); }
+
+    ScopedGrant(const ScopedGrant&) = delete;
+    ScopedGrant& operator=(const ScopedGrant&) = delete;
+
+private:
+    SafetyMatrix& state_;
+    std::size_t row_;
+    std::size_t col_;
+    ResourceQuantity quantity_;
+};
+
+// Applies several hypothetical grants to existing cells and undoes every
+// one applied, in reverse, on scope exit
+class ScopedGrants {
+public:
+    ScopedGrants(SafetyMatrix& state, std::size_t count) : state_(state) {
+        applied_.reserve(count);  // so recording a grant cannot throw
+    }
+    ~ScopedGrants() {
+        for (auto it = applied_.rbegin(); it != applied_.rend(); ++it) {
+            state_.allocate(it->row, it->col, -it->quantity);
         }
     }
-    return true;
-}
-
-} // anonymous namespace
 
-SafetyCheckResult SafetyChecker::check_safety(const SafetyCheckInput& input) const {
-    SafetyCheckResult result;
-    auto resource_types = collect_resource_types(input);
+    ScopedGrants(const ScopedGrants&) = delete;
+    ScopedGrants& operator=(const ScopedGrants&) = delete;
 
-    // Collect all agent IDs
-    std::vector<AgentId> agents;
-    for (auto& [aid, _] : input.max_need) {
-        agents.push_back(aid);
-    }
-    // Also include agents with allocations but no max_need entry
-    for (auto& [aid, _] : input.allocation) {
-        if (input.max_need.find(aid) == input.max_need.end()) {
-            agents.push_back(aid);
-        }
+    void apply(std::size_t row, std::size_t col, ResourceQuantity quantity) {
+        state_.allocate(row, col, quantity);
+        applied_.push_back({row, col, quantity});
     }
 
-    if (agents.empty()) {
-        result.is_safe = true;
-        result.reason = "No agents in the system";
-        return result;
+private:
+    struct Grant {
+        std::size_t row;
+        std::size_t col;
+        ResourceQuantity quantity;
+    };
+    SafetyMatrix& state_;
+    std::vector<Grant> applied_;
+};
+
+// Per-thread scratch buffers so repeated checks reuse their storage while
+// SafetyChecker itself stays stateless and safe to share between threads
+struct Scratch {
+    std::vector<ResourceQuantity> work;
+    std::vector<unsigned char> finished;
+
+    // Worklist engine
+    std::vector<std::size_t> blocked;        // per row: columns still short
+    std::vector<std::size_t> ready;          // rows that can finish, FIFO
+    std::vector<std::pair<ResourceQuantity, std::size_t>> waiters;  // (need, row)
+    std::vector<std::size_t> waiter_begin;   // per column: start in waiters
+    std::vector<std::size_t> waiter_next;    // per column: first still blocked
+};
+
+Scratch& scratch() {
+    thread_local Scratch s;
+    return s;
+}
+
+void describe_unsafe(const SafetyMatrix& state,
+                     const std::vector<unsigned char>& finished,
+                     SafetyCheckResult& result)
+{
+    result.is_safe = false;
+    result.safe_sequence.clear();
+
+    result.reason.assign("Unsafe state: agents [");
+    bool first = true;
+    for (std::size_t row = 0; row < state.row_count(); ++row) {
+        if (state.row_active(row) && !finished[row]) {
+            if (!first) result.reason += ", ";
+            result.reason += std::to_string(state.agent_at(row));
+            first = false;
+        }
     }
+    result.reason += "] cannot complete with available resources";
+}
 
-    // Banker's Algorithm: try to find a safe sequence
-    std::unordered_map<ResourceTypeId, ResourceQuantity> work = input.available;
-    std::unordered_set<AgentId> finished;
-    std::vector<AgentId> safe_sequence;
+// Banker's Algorithm, round-based: each round re-scans every unfinished
+// agent until a round makes no progress
+void run_classic(const SafetyMatrix& state, const detail::SafetyKernels& kernels,
+                 Scratch& s, SafetyCheckResult& result)
+{
+    const std::size_t cols = state.stride();
+    const std::size_t rows = state.row_count();
 
-    std::size_t n = agents.size();
+    std::size_t n = state.agent_count();
     for (std::size_t round = 0; round < n; ++round) {
         bool found_one = false;
 
-        for (auto aid : agents) {
-            if (finished.count(aid)) continue;
+        for (std::size_t row = 0; row < rows; ++row) {
+            if (s.finished[row] || !state.row_active(row)) continue;
 
-            if (can_finish(input, aid, work, resource_types)) {
+            if (kernels.can_finish(state.need_row(row), s.work.data(), cols)) {
                 // This agent can finish. Simulate it releasing its resources.
-                for (auto rt : resource_types) {
-                    work[rt] += get_allocation(input, aid, rt);
-                }
-                finished.insert(aid);
-                safe_sequence.push_back(aid);
+                kernels.release_row(s.work.data(), state.allocation_row(row), cols);
+                s.finished[row] = 1;
+                result.safe_sequence.push_back(state.agent_at(row));
                 found_one = true;
             }
         }
 
         if (!found_one) {
             // No agent could finish in this round
-            if (finished.size() == agents.size()) {
+            if (result.safe_sequence.size() == n) {
                 // All agents already finished - we're done
                 break;
             }
             // Truly unsafe: remaining agents cannot complete
-            result.is_safe = false;
-            result.safe_sequence.clear();
-
-            std::string blocked_agents;
-            for (auto aid : agents) {
-                if (!finished.count(aid)) {
-                    if (!blocked_agents.empty()) blocked_agents += ", ";
-                    blocked_agents += std::to_string(aid);
-                }
+            describe_unsafe(state, s.finished, result);
+            return;
+        }
+    }
+
+    result.is_safe = true;
+    result.reason.assign("Safe state found");
+}
+
+// Banker's Algorithm, worklist form. Each agent counts the resource types
+// it is still short on; each resource keeps its short agents sorted by
+// need. When an agent finishes, only the columns it releases are advanced,
+// and an agent becomes ready once its counter reaches zero.
+void run_worklist(const SafetyMatrix& state, Scratch& s, SafetyCheckResult& result) {
+    const std::size_t cols = state.stride();
+    const std::size_t rows = state.row_count();
+
+    s.blocked.assign(rows, 0);
+    s.ready.clear();
+    s.waiters.clear();
+    s.waiter_begin.assign(cols + 1, 0);
+    s.waiter_next.assign(cols, 0);
+
+    for (std::size_t col = 0; col < cols; ++col) {
+        s.waiter_begin[col] = s.waiters.size();
+        if (!state.column_active(col)) continue;
+        for (std::size_t row = 0; row < rows; ++row) {
+            if (!state.row_active(row)) continue;
+            ResourceQuantity need = state.need(row, col);
+            if (need > s.work[col]) {
+                s.waiters.emplace_back(need, row);
+                ++s.blocked[row];
             }
-            result.reason = "Unsafe state: agents [" + blocked_agents +
-                           "] cannot complete with available resources";
-            return result;
         }
+        std::sort(s.waiters.begin() + static_cast<std::ptrdiff_t>(s.waiter_begin[col]),
+                  s.waiters.end());
+        s.waiter_next[col] = s.waiter_begin[col];
+    }
+    s.waiter_begin[cols] = s.waiters.size();
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (state.row_active(row) && s.blocked[row] == 0) s.ready.push_back(row);
+    }
+
+    for (std::size_t head = 0; head < s.ready.size(); ++head) {
+        std::size_t row = s.ready[head];
+        s.finished[row] = 1;
+        result.safe_sequence.push_back(state.agent_at(row));
+
+        const ResourceQuantity* alloc = state.allocation_row(row);
+        for (std::size_t col = 0; col < cols; ++col) {
+            if (alloc[col] == 0) continue;
+            s.work[col] += alloc[col];
+
+            std::size_t& next = s.waiter_next[col];
+            std::size_t end = s.waiter_begin[col + 1];
+            while (next < end && s.waiters[next].first <= s.work[col]) {
+                std::size_t woken = s.waiters[next].second;
+                if (--s.blocked[woken] == 0) s.ready.push_back(woken);
+                ++next;
+            }
+        }
+    }
+
+    if (result.safe_sequence.size() != state.agent_count()) {
+        describe_unsafe(state, s.finished, result);
+        return;
     }
 
     result.is_safe = true;
-    result.safe_sequence = std::move(safe_sequence);
-    result.reason = "Safe state found";
+    result.reason.assign("Safe state found");
+}
+
+} // anonymous namespace
+
+SafetyChecker::SafetyChecker(SafetyAlgorithm algorithm, bool use_simd_kernels)
+    : algorithm_(algorithm)
+    , kernels_(use_simd_kernels ? &detail::best_safety_kernels()
+                                : &detail::scalar_safety_kernels())
+{
+}
+
+const char* SafetyChecker::kernel_name() const noexcept {
+    return kernels_->name;
+}
+
+SafetyCheckResult SafetyChecker::check_safety(const SafetyCheckInput& input) const {
+    return check_safety(SafetyMatrix::from_input(input));
+}
+
+SafetyCheckResult SafetyChecker::check_safety(const SafetyMatrix& state) const {
+    SafetyCheckResult result;
+    check_safety(state, result);
     return result;
 }
 
+void SafetyChecker::check_safety(const SafetyMatrix& state, SafetyCheckResult& result) const {
+    result.safe_sequence.clear();
+
+    if (state.agent_count() == 0) {
+        result.is_safe = true;
+        result.reason.assign("No agents in the system");
+        return;
+    }
+
+    auto& s = scratch();
+    s.work.assign(state.available_data(), state.available_data() + state.stride());
+    s.finished.assign(state.row_count(), 0);
+    result.safe_sequence.reserve(state.agent_count());
+
+    if (algorithm_ == SafetyAlgorithm::Worklist) {
+        run_worklist(state, s, result);
+    } else {
+        run_classic(state, *kernels_, s, result);
+    }
+}
+
 SafetyCheckResult SafetyChecker::check_hypothetical(
     const SafetyCheckInput& current_state,
     AgentId requesting_agent,
     ResourceTypeId resource_type,
     ResourceQuantity quantity) const
+{
+    auto state = SafetyMatrix::from_input(current_state);
+    return check_hypothetical_in_place(state, requesting_agent, resource_type, quantity);
+}
+
+SafetyCheckResult SafetyChecker::check_hypothetical(
+    const SafetyMatrix& current_state,
+    AgentId requesting_agent,
+    ResourceTypeId resource_type,
+    ResourceQuantity quantity) const
 {
     // Create a modified state as if the request were granted
-    SafetyCheckInput hypothetical = current_state;
+    SafetyMatrix hypothetical = current_state;
+    apply_grant(hypothetical, requesting_agent, resource_type, quantity);
+    return check_safety(hypothetical);
+}
+
+SafetyCheckResult SafetyChecker::check_hypothetical_in_place(
+    SafetyMatrix& current_state,
+    AgentId requesting_agent,
+    ResourceTypeId resource_type,
+    ResourceQuantity quantity) const
+{
+    SafetyCheckResult result;
+    check_hypothetical_in_place(current_state, requesting_agent, resource_type, quantity,
+                                result);
+    return result;
+}
+
+void SafetyChecker::check_hypothetical_in_place(
+    SafetyMatrix& current_state,
+    AgentId requesting_agent,
+    ResourceTypeId resource_type,
+    ResourceQuantity quantity,
+    SafetyCheckResult& result) const
+{
+    std::size_t row = current_state.agent_slot(requesting_agent);
+    std::size_t col = current_state.resource_slot(resource_type);
+    if (row == SafetyMatrix::npos || col == SafetyMatrix::npos) {
+        // Unknown agent or resource: fall back to a copy rather than
+        // growing the caller's layout
+        result = check_hypothetical(std::as_const(current_state),
+                                    requesting_agent, resource_type, quantity);
+        return;
+    }
 
-    // Decrease available
-    hypothetical.available[resource_type] -= quantity;
+    ScopedGrant grant(current_state, row, col, quantity);
+    check_safety(current_state, result);
+}
 
-    // Increase agent's allocation
-    hypothetical.allocation[requesting_agent][resource_type] += quantity;
+bool SafetyChecker::replay_sequence(const SafetyMatrix& state,
+                                    const std::vector<AgentId>& sequence) const
+{
+    if (sequence.size() != state.agent_count()) return false;
+
+    const std::size_t cols = state.stride();
+    auto& s = scratch();
+    s.work.assign(state.available_data(), state.available_data() + cols);
+
+    // Sequences come from earlier checks, so ids are distinct and matching
+    // the agent count means every active row is covered
+    for (AgentId agent : sequence) {
+        std::size_t row = state.agent_slot(agent);
+        if (row == SafetyMatrix::npos) return false;
+        if (!kernels_->can_finish(state.need_row(row), s.work.data(), cols)) return false;
+        kernels_->release_row(s.work.data(), state.allocation_row(row), cols);
+    }
+    return true;
+}
 
-    return check_safety(hypothetical);
+bool SafetyChecker::replay_hypothetical(
+    SafetyMatrix& current_state,
+    AgentId requesting_agent,
+    ResourceTypeId resource_type,
+    ResourceQuantity quantity,
+    const std::vector<AgentId>& sequence) const
+{
+    std::size_t row = current_state.agent_slot(requesting_agent);
+    std::size_t col = current_state.resource_slot(resource_type);
+    if (row == SafetyMatrix::npos || col == SafetyMatrix::npos) return false;
+
+    ScopedGrant grant(current_state, row, col, quantity);
+    return replay_sequence(current_state, sequence);
 }
 
 SafetyCheckResult SafetyChecker::check_hypothetical_batch(
     const SafetyCheckInput& current_state,
     const std::vector<ResourceRequest>& requests) const
 {
-    SafetyCheckInput hypothetical = current_state;
+    auto state = SafetyMatrix::from_input(current_state);
+    return check_hypothetical_batch_in_place(state, requests);
+}
+
+SafetyCheckResult SafetyChecker::check_hypothetical_batch(
+    const SafetyMatrix& current_state,
+    const std::vector<ResourceRequest>& requests) const
+{
+    SafetyMatrix hypothetical = current_state;
 
     for (auto& req : requests) {
-        hypothetical.available[req.resource_type] -= req.quantity;
-        hypothetical.allocation[req.agent_id][req.resource_type] += req.quantity;
+        apply_grant(hypothetical, req.agent_id, req.resource_type, req.quantity);
     }
 
     return check_safety(hypothetical);
 }
 
+SafetyCheckResult SafetyChecker::check_hypothetical_batch_in_place(
+    SafetyMatrix& current_state,
+    const std::vector<ResourceRequest>& requests) const
+{
+    // Resolve every cell before touching the matrix
+    std::vector<std::pair<std::size_t, std::size_t>> cells;
+    cells.reserve(requests.size());
+    for (auto& req : requests) {
+        std::size_t row = current_state.agent_slot(req.agent_id);
+        std::size_t col = current_state.resource_slot(req.resource_type);
+        if (row == SafetyMatrix::npos || col == SafetyMatrix::npos) {
+            return check_hypothetical_batch(std::as_const(current_state), requests);
+        }
+        cells.emplace_back(row, col);
+    }
+
+    ScopedGrants grants(current_state, requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        grants.apply(cells[i].first, cells[i].second, requests[i].quantity);
+    }
+    SafetyCheckResult result;
+    check_safety(current_state, result);
+    return result;
+}
+
 std::vector<RequestId> SafetyChecker::find_grantable_requests(
     const SafetyCheckInput& current_state,
     const std::vector<ResourceRequest>& candidates) const
+{
+    auto state = SafetyMatrix::from_input(current_state);
+    return find_grantable_requests_in_place(state, candidates);
+}
+
+std::vector<RequestId> SafetyChecker::find_grantable_requests(
+    const SafetyMatrix& current_state,
+    const std::vector<ResourceRequest>& candidates) const
+{
+    // One copy up front; every candidate is then evaluated in place
+    SafetyMatrix state = current_state;
+    return find_grantable_requests_in_place(state, candidates);
+}
+
+std::vector<RequestId> SafetyChecker::find_grantable_requests_in_place(
+    SafetyMatrix& current_state,
+    const std::vector<ResourceRequest>& candidates) const
 {
     std::vector<RequestId> grantable;
+    SafetyCheckResult result;
 
     for (auto& req : candidates) {
         // Quick check: is there enough available?
-        auto avail_it = current_state.available.find(req.resource_type);
-        if (avail_it == current_state.available.end() || avail_it->second < req.quantity) {
+        std::size_t col = current_state.resource_slot(req.resource_type);
+        if (col == SafetyMatrix::npos || current_state.available(col) < req.quantity) {
             continue;
         }
 
-        auto result = check_hypothetical(
-            current_state, req.agent_id, req.resource_type, req.quantity);
+        check_hypothetical_in_place(current_state, req.agent_id, req.resource_type,
+                                    req.quantity, result);
 
         if (result.is_safe) {
             grantable.push_back(req.id);
@@ -213,6 +474,7 @@ std::vector<RequestId> SafetyChecker::find_grantable_requests(
     return grantable;
 }
 
+
 std::vector<AgentId> SafetyChecker::identify_bottleneck_agents(
     const SafetyCheckInput& input) const
 {
@@ -293,12 +555,19 @@ ProbabilisticSafetyResult SafetyChecker::check_hypothetical_probabilistic(
     ResourceQuantity quantity,
     double confidence_level) const
 {
-    // Build hypothetical state with the grant applied
-    SafetyCheckInput hypothetical = current_state;
-    hypothetical.available[resource] -= quantity;
-    hypothetical.allocation[agent][resource] += quantity;
+    // Evaluate the grant against a dense view of the state; max needs are
+    // unaffected by a grant, so the estimates are reported from the input
+    auto state = SafetyMatrix::from_input(current_state);
+    auto binary_result = check_hypothetical_in_place(state, agent, resource, quantity);
 
-    return check_safety_probabilistic(hypothetical, confidence_level);
+    ProbabilisticSafetyResult result;
+    result.is_safe = binary_result.is_safe;
+    result.confidence_level = confidence_level;
+    result.safe_sequence = std::move(binary_result.safe_sequence);
+    result.reason = std::move(binary_result.reason);
+    result.max_safe_confidence = binary_result.is_safe ? confidence_level : 0.0;
+    result.estimated_max_needs = current_state.max_need;
+    return result;
 }
 
 } // namespace agentguard
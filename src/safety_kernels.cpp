@@ -0,0 +1,132 @@
+#include "safety_kernels.hpp"
+
+#if defined(AGENTGUARD_ENABLE_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define AGENTGUARD_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace agentguard::detail {
+
+namespace {
+
+bool can_finish_scalar(const ResourceQuantity* need,
+                       const ResourceQuantity* work,
+                       std::size_t cols)
+{
+    for (std::size_t c = 0; c < cols; ++c) {
+        if (need[c] > work[c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void release_row_scalar(ResourceQuantity* work,
+                        const ResourceQuantity* alloc,
+                        std::size_t cols)
+{
+    for (std::size_t c = 0; c < cols; ++c) {
+        work[c] += alloc[c];
+    }
+}
+
+constexpr SafetyKernels kScalar{"scalar", can_finish_scalar, release_row_scalar};
+
+#ifdef AGENTGUARD_X86_KERNELS
+
+// Compiled for the target ISA via function attributes so the rest of the
+// library keeps the baseline ISA; only called after a runtime CPU check.
+// Casts below are the intrinsics' documented unaligned-access idiom.
+
+__attribute__((target("avx2")))
+bool can_finish_avx2(const ResourceQuantity* need,
+                     const ResourceQuantity* work,
+                     std::size_t cols)
+{
+    std::size_t c = 0;
+    for (; c + 4 <= cols; c += 4) {
+        __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(need + c));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(work + c));
+        __m256i short_lanes = _mm256_cmpgt_epi64(n, w);
+        if (!_mm256_testz_si256(short_lanes, short_lanes)) {
+            return false;
+        }
+    }
+    return can_finish_scalar(need + c, work + c, cols - c);
+}
+
+__attribute__((target("avx2")))
+void release_row_avx2(ResourceQuantity* work,
+                      const ResourceQuantity* alloc,
+                      std::size_t cols)
+{
+    std::size_t c = 0;
+    for (; c + 4 <= cols; c += 4) {
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(work + c));
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(alloc + c));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(work + c), _mm256_add_epi64(w, a));
+    }
+    release_row_scalar(work + c, alloc + c, cols - c);
+}
+
+__attribute__((target("avx512f")))
+bool can_finish_avx512(const ResourceQuantity* need,
+                       const ResourceQuantity* work,
+                       std::size_t cols)
+{
+    std::size_t c = 0;
+    for (; c + 8 <= cols; c += 8) {
+        __m512i n = _mm512_loadu_si512(need + c);
+        __m512i w = _mm512_loadu_si512(work + c);
+        if (_mm512_cmpgt_epi64_mask(n, w) != 0) {
+            return false;
+        }
+    }
+    return can_finish_scalar(need + c, work + c, cols - c);
+}
+
+__attribute__((target("avx512f")))
+void release_row_avx512(ResourceQuantity* work,
+                        const ResourceQuantity* alloc,
+                        std::size_t cols)
+{
+    std::size_t c = 0;
+    for (; c + 8 <= cols; c += 8) {
+        __m512i w = _mm512_loadu_si512(work + c);
+        __m512i a = _mm512_loadu_si512(alloc + c);
+        _mm512_storeu_si512(work + c, _mm512_add_epi64(w, a));
+    }
+    release_row_scalar(work + c, alloc + c, cols - c);
+}
+
+constexpr SafetyKernels kAvx2{"avx2", can_finish_avx2, release_row_avx2};
+constexpr SafetyKernels kAvx512{"avx512", can_finish_avx512, release_row_avx512};
+
+const SafetyKernels& detect() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return kAvx512;
+    if (__builtin_cpu_supports("avx2")) return kAvx2;
+    return kScalar;
+}
+
+#else
+
+const SafetyKernels& detect() noexcept {
+    return kScalar;
+}
+
+#endif
+
+} // anonymous namespace
+
+const SafetyKernels& scalar_safety_kernels() noexcept {
+    return kScalar;
+}
+
+const SafetyKernels& best_safety_kernels() noexcept {
+    static const SafetyKernels& best = detect();
+    return best;
+}
+
+} // namespace agentguard::detail
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "agentguard/types.hpp"
+
+#include <cstddef>
+
+namespace agentguard::detail {
+
+// Row kernels for the dense safety loop. Rows are SafetyMatrix rows, so cols
+// is normally a multiple of 8, but every kernel also handles a ragged tail.
+struct SafetyKernels {
+    const char* name;
+
+    // all(need[c] <= work[c])
+    bool (*can_finish)(const ResourceQuantity* need,
+                       const ResourceQuantity* work,
+                       std::size_t cols);
+
+    // work[c] += alloc[c]
+    void (*release_row)(ResourceQuantity* work,
+                        const ResourceQuantity* alloc,
+                        std::size_t cols);
+};
+
+// Portable implementation, always available.
+const SafetyKernels& scalar_safety_kernels() noexcept;
+
+// Widest implementation the running CPU supports (AVX-512, AVX2, or scalar).
+// Detected once on first use.
+const SafetyKernels& best_safety_kernels() noexcept;
+
+} // namespace agentguard::detail
@@ -0,0 +1,261 @@
+#include "agentguard/safety_matrix.hpp"
+#include "agentguard/safety_checker.hpp"
+
+#include <algorithm>
+
+namespace agentguard {
+
+namespace {
+
+// Columns are allocated in blocks so rows stay aligned to whole blocks.
+constexpr std::size_t kColumnBlock = 8;
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Adapters
+// ---------------------------------------------------------------------------
+
+SafetyMatrix SafetyMatrix::from_input(const SafetyCheckInput& input) {
+    SafetyMatrix m;
+
+    for (auto& [rt, qty] : input.total) {
+        m.set_total(m.add_resource(rt), qty);
+    }
+    for (auto& [rt, qty] : input.available) {
+        m.set_available(m.add_resource(rt), qty);
+    }
+
+    // Agent rows follow the same order the map-based check used: agents with
+    // a max_need entry first, then agents that only hold an allocation.
+    for (auto& [aid, needs] : input.max_need) {
+        std::size_t row = m.add_agent(aid);
+        for (auto& [rt, qty] : needs) {
+            std::size_t col = m.resource_slot(rt);
+            if (col != npos) m.set_max_need(row, col, qty);
+        }
+    }
+    for (auto& [aid, alloc] : input.allocation) {
+        std::size_t row = m.add_agent(aid);
+        for (auto& [rt, qty] : alloc) {
+            std::size_t col = m.resource_slot(rt);
+            if (col != npos) m.set_allocation(row, col, qty);
+        }
+    }
+
+    return m;
+}
+
+SafetyCheckInput SafetyMatrix::to_input() const {
+    SafetyCheckInput input;
+
+    for (std::size_t col = 0; col < stride_; ++col) {
+        if (!column_active_[col]) continue;
+        input.total[resource_ids_[col]] = total_[col];
+        input.available[resource_ids_[col]] = available_[col];
+    }
+
+    for (std::size_t row = 0; row < row_count_; ++row) {
+        if (!row_active_[row]) continue;
+        AgentId aid = agent_ids_[row];
+        auto& alloc = input.allocation[aid];
+        auto& max = input.max_need[aid];
+        for (std::size_t col = 0; col < stride_; ++col) {
+            if (!column_active_[col]) continue;
+            ResourceTypeId rt = resource_ids_[col];
+            if (allocation_[cell(row, col)] != 0) alloc[rt] = allocation_[cell(row, col)];
+            if (max_need_[cell(row, col)] != 0) max[rt] = max_need_[cell(row, col)];
+        }
+    }
+
+    return input;
+}
+
+// ---------------------------------------------------------------------------
+// Slot management
+// ---------------------------------------------------------------------------
+
+std::size_t SafetyMatrix::add_resource(ResourceTypeId id) {
+    auto it = resource_slots_.find(id);
+    if (it != resource_slots_.end()) return it->second;
+
+    std::size_t col;
+    if (!free_columns_.empty()) {
+        col = free_columns_.back();
+        free_columns_.pop_back();
+    } else {
+        if (resource_count_ == stride_) grow_columns();
+        // Without free columns, live columns are exactly [0, resource_count_)
+        col = resource_count_;
+    }
+
+    resource_ids_[col] = id;
+    column_active_[col] = 1;
+    resource_slots_.emplace(id, col);
+    ++resource_count_;
+    return col;
+}
+
+bool SafetyMatrix::remove_resource(ResourceTypeId id) {
+    auto it = resource_slots_.find(id);
+    if (it == resource_slots_.end()) return false;
+
+    std::size_t col = it->second;
+    for (std::size_t row = 0; row < row_count_; ++row) {
+        allocation_[cell(row, col)] = 0;
+        max_need_[cell(row, col)] = 0;
+        need_[cell(row, col)] = 0;
+    }
+    total_[col] = 0;
+    available_[col] = 0;
+    resource_ids_[col] = 0;
+    column_active_[col] = 0;
+
+    resource_slots_.erase(it);
+    free_columns_.push_back(col);
+    --resource_count_;
+    return true;
+}
+
+std::size_t SafetyMatrix::add_agent(AgentId id) {
+    auto it = agent_slots_.find(id);
+    if (it != agent_slots_.end()) return it->second;
+
+    std::size_t row;
+    if (!free_rows_.empty()) {
+        row = free_rows_.back();
+        free_rows_.pop_back();
+    } else {
+        row = row_count_++;
+        agent_ids_.resize(row_count_, 0);
+        row_active_.resize(row_count_, 0);
+        allocation_.resize(row_count_ * stride_, 0);
+        max_need_.resize(row_count_ * stride_, 0);
+        need_.resize(row_count_ * stride_, 0);
+    }
+
+    agent_ids_[row] = id;
+    row_active_[row] = 1;
+    agent_slots_.emplace(id, row);
+    ++agent_count_;
+    return row;
+}
+
+bool SafetyMatrix::remove_agent(AgentId id) {
+    auto it = agent_slots_.find(id);
+    if (it == agent_slots_.end()) return false;
+
+    std::size_t row = it->second;
+    std::fill_n(allocation_.begin() + static_cast<std::ptrdiff_t>(cell(row, 0)), stride_, 0);
+    std::fill_n(max_need_.begin() + static_cast<std::ptrdiff_t>(cell(row, 0)), stride_, 0);
+    std::fill_n(need_.begin() + static_cast<std::ptrdiff_t>(cell(row, 0)), stride_, 0);
+    agent_ids_[row] = 0;
+    row_active_[row] = 0;
+
+    agent_slots_.erase(it);
+    free_rows_.push_back(row);
+    --agent_count_;
+    return true;
+}
+
+void SafetyMatrix::grow_columns() {
+    std::size_t new_stride = std::max(kColumnBlock, stride_ * 2);
+
+    auto relayout = [&](std::vector<ResourceQuantity>& cells) {
+        std::vector<ResourceQuantity> grown(row_count_ * new_stride, 0);
+        for (std::size_t row = 0; row < row_count_; ++row) {
+            std::copy_n(cells.begin() + static_cast<std::ptrdiff_t>(row * stride_), stride_,
+                        grown.begin() + static_cast<std::ptrdiff_t>(row * new_stride));
+        }
+        cells.swap(grown);
+    };
+    relayout(allocation_);
+    relayout(max_need_);
+    relayout(need_);
+
+    resource_ids_.resize(new_stride, 0);
+    column_active_.resize(new_stride, 0);
+    total_.resize(new_stride, 0);
+    available_.resize(new_stride, 0);
+    stride_ = new_stride;
+}
+
+std::size_t SafetyMatrix::agent_slot(AgentId id) const noexcept {
+    auto it = agent_slots_.find(id);
+    return (it != agent_slots_.end()) ? it->second : npos;
+}
+
+std::size_t SafetyMatrix::resource_slot(ResourceTypeId id) const noexcept {
+    auto it = resource_slots_.find(id);
+    return (it != resource_slots_.end()) ? it->second : npos;
+}
+
+AgentId SafetyMatrix::agent_at(std::size_t row) const noexcept { return agent_ids_[row]; }
+ResourceTypeId SafetyMatrix::resource_at(std::size_t col) const noexcept { return resource_ids_[col]; }
+bool SafetyMatrix::row_active(std::size_t row) const noexcept { return row_active_[row] != 0; }
+bool SafetyMatrix::column_active(std::size_t col) const noexcept { return column_active_[col] != 0; }
+
+std::size_t SafetyMatrix::agent_count() const noexcept { return agent_count_; }
+std::size_t SafetyMatrix::resource_count() const noexcept { return resource_count_; }
+std::size_t SafetyMatrix::row_count() const noexcept { return row_count_; }
+std::size_t SafetyMatrix::stride() const noexcept { return stride_; }
+
+// ---------------------------------------------------------------------------
+// Cells
+// ---------------------------------------------------------------------------
+
+ResourceQuantity SafetyMatrix::total(std::size_t col) const noexcept { return total_[col]; }
+ResourceQuantity SafetyMatrix::available(std::size_t col) const noexcept { return available_[col]; }
+
+ResourceQuantity SafetyMatrix::allocation(std::size_t row, std::size_t col) const noexcept {
+    return allocation_[cell(row, col)];
+}
+
+ResourceQuantity SafetyMatrix::max_need(std::size_t row, std::size_t col) const noexcept {
+    return max_need_[cell(row, col)];
+}
+
+ResourceQuantity SafetyMatrix::need(std::size_t row, std::size_t col) const noexcept {
+    return need_[cell(row, col)];
+}
+
+void SafetyMatrix::set_total(std::size_t col, ResourceQuantity qty) noexcept {
+    total_[col] = qty;
+}
+
+void SafetyMatrix::set_available(std::size_t col, ResourceQuantity qty) noexcept {
+    available_[col] = qty;
+}
+
+void SafetyMatrix::set_max_need(std::size_t row, std::size_t col, ResourceQuantity qty) noexcept {
+    std::size_t c = cell(row, col);
+    max_need_[c] = qty;
+    need_[c] = qty - allocation_[c];
+}
+
+void SafetyMatrix::set_allocation(std::size_t row, std::size_t col, ResourceQuantity qty) noexcept {
+    std::size_t c = cell(row, col);
+    allocation_[c] = qty;
+    need_[c] = max_need_[c] - qty;
+}
+
+void SafetyMatrix::allocate(std::size_t row, std::size_t col, ResourceQuantity qty) noexcept {
+    std::size_t c = cell(row, col);
+    allocation_[c] += qty;
+    need_[c] -= qty;
+    available_[col] -= qty;
+}
+
+const ResourceQuantity* SafetyMatrix::available_data() const noexcept {
+    return available_.data();
+}
+
+const ResourceQuantity* SafetyMatrix::allocation_row(std::size_t row) const noexcept {
+    return allocation_.data() + cell(row, 0);
+}
+
+const ResourceQuantity* SafetyMatrix::need_row(std::size_t row) const noexcept {
+    return need_.data() + cell(row, 0);
+}
+
+} // namespace agentguard
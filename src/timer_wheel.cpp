@@ -0,0 +1,83 @@
+#include "agentguard/timer_wheel.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace agentguard {
+
+TimerWheel::TimerWheel(Duration tick, std::size_t slots, Timestamp origin)
+    : tick_(tick)
+    , origin_(origin)
+    , buckets_(slots)
+{
+    if (tick_ <= Duration::zero() || slots == 0) {
+        throw std::invalid_argument("TimerWheel needs a positive tick and at least one slot");
+    }
+}
+
+std::uint64_t TimerWheel::tick_at(Timestamp t, bool round_up) const {
+    if (t <= origin_) return 0;
+    auto offset = t - origin_;
+    auto ticks = static_cast<std::uint64_t>(offset / tick_);
+    if (round_up && offset % tick_ != Duration::zero()) ++ticks;
+    return ticks;
+}
+
+bool TimerWheel::schedule(Timestamp when, std::uint64_t key) {
+    std::uint64_t tick = std::max(tick_at(when, true), current_);
+    buckets_[tick % buckets_.size()].push_back(Timer{tick, key});
+    bool earliest = size_ == 0 || tick < earliest_;
+    if (earliest) earliest_ = tick;
+    ++size_;
+    return earliest;
+}
+
+std::vector<std::uint64_t> TimerWheel::advance(Timestamp now) {
+    std::vector<std::uint64_t> fired;
+    std::uint64_t target = tick_at(now, false);
+    if (target < current_) return fired;
+    if (size_ == 0 || target < earliest_) {
+        current_ = target + 1;
+        return fired;
+    }
+
+    // One lap visits every bucket, so a long gap costs no more than that
+    std::uint64_t laps_end = std::min(target + 1, current_ + buckets_.size());
+    for (std::uint64_t t = current_; t < laps_end; ++t) {
+        auto& bucket = buckets_[t % buckets_.size()];
+        for (std::size_t i = 0; i < bucket.size();) {
+            if (bucket[i].tick <= target) {
+                fired.push_back(bucket[i].key);
+                bucket[i] = bucket.back();
+                bucket.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+    size_ -= fired.size();
+    current_ = target + 1;
+    find_earliest();
+    return fired;
+}
+
+std::optional<Timestamp> TimerWheel::next_expiry() const {
+    if (size_ == 0) return std::nullopt;
+    return origin_ + tick_ * static_cast<Duration::rep>(earliest_);
+}
+
+void TimerWheel::find_earliest() {
+    if (size_ == 0) return;
+    for (std::uint64_t t = current_; t < current_ + buckets_.size(); ++t) {
+        for (auto& timer : buckets_[t % buckets_.size()]) {
+            if (timer.tick == t) {
+                earliest_ = t;
+                return;
+            }
+        }
+    }
+    // Everything is at least a lap away: look again at the end of this one
+    earliest_ = current_ + buckets_.size();
+}
+
+} // namespace agentguard
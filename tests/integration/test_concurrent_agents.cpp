@@ -280,6 +280,113 @@ TEST(ConcurrentAgentsTest, AsyncRequests) {
     EXPECT_TRUE(mgr.is_safe());
 }
 
+TEST(ConcurrentAgentsTest, AsyncRequestsQueueWithoutThreads) {
+    constexpr int NUM_AGENTS = 64;
+
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.start();
+    mgr.register_resource(Resource(1, "Pool", ResourceCategory::ToolSlot, NUM_AGENTS));
+
+    Agent holder(1000, "Holder");
+    holder.declare_max_need(1, NUM_AGENTS);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, NUM_AGENTS, 1s), RequestStatus::Granted);
+
+    std::vector<std::future<RequestStatus>> futures;
+    for (int i = 0; i < NUM_AGENTS; ++i) {
+        Agent a(static_cast<AgentId>(i + 1), "Agent-" + std::to_string(i));
+        a.declare_max_need(1, 1);
+        AgentId id = mgr.register_agent(std::move(a));
+        futures.push_back(mgr.request_resources_async(id, 1, 1, 10s));
+    }
+    // Every request is parked in the queue rather than on a thread
+    EXPECT_EQ(mgr.pending_request_count(), static_cast<std::size_t>(NUM_AGENTS));
+    EXPECT_EQ(futures.front().wait_for(0ms), std::future_status::timeout);
+
+    mgr.release_all_resources(holder_id, 1);
+    for (auto& f : futures) {
+        ASSERT_EQ(f.wait_for(5s), std::future_status::ready);
+        EXPECT_EQ(f.get(), RequestStatus::Granted);
+    }
+    EXPECT_EQ(mgr.get_resource(1)->available(), 0);
+
+    // Expiry and validation errors also reach the future
+    Agent late(2000, "Late");
+    late.declare_max_need(1, 1);
+    AgentId late_id = mgr.register_agent(std::move(late));
+    EXPECT_EQ(mgr.request_resources_async(late_id, 1, 1, 20ms).get(), RequestStatus::TimedOut);
+    auto bad = mgr.request_resources_async(late_id, 1, 2);
+    EXPECT_THROW(bad.get(), MaxClaimExceededException);
+    mgr.stop();
+}
+
+TEST(ConcurrentAgentsTest, AsyncRequestsWaitForProcessor) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Pool", ResourceCategory::ToolSlot, 1));
+    mgr.register_resource(Resource(2, "Spare", ResourceCategory::ToolSlot, 1));
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    Agent waiter(2, "Waiter");
+    waiter.declare_max_need(1, 1);
+    waiter.declare_max_need(2, 1);
+    AgentId waiter_id = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, 1, 1s), RequestStatus::Granted);
+
+    // Never started: what fits is granted at once, the rest is parked in
+    // the queue rather than on a thread
+    EXPECT_EQ(mgr.request_resources_async(waiter_id, 2, 1, 5s).get(), RequestStatus::Granted);
+    mgr.release_all_resources(waiter_id, 2);
+    auto timed_out = mgr.request_resources_async(waiter_id, 1, 1, 20ms);
+    auto granted = mgr.request_resources_batch_async(waiter_id, {{1, 1}, {2, 1}}, 5s);
+    EXPECT_EQ(mgr.pending_request_count(), 2u);
+    std::this_thread::sleep_for(50ms);
+    mgr.release_all_resources(holder_id, 1);
+    EXPECT_EQ(granted.wait_for(20ms), std::future_status::timeout);
+
+    // The processor expires and grants them once it runs
+    mgr.start();
+    ASSERT_EQ(timed_out.wait_for(2s), std::future_status::ready);
+    EXPECT_EQ(timed_out.get(), RequestStatus::TimedOut);
+    ASSERT_EQ(granted.wait_for(2s), std::future_status::ready);
+    EXPECT_EQ(granted.get(), RequestStatus::Granted);
+    mgr.stop();
+}
+
+TEST(ConcurrentAgentsTest, StopCancelsOutstandingAsyncRequests) {
+    Config cfg;
+    cfg.thread_safe = true;
+    auto mgr = std::make_unique<ResourceManager>(cfg);
+    mgr->start();
+    mgr->register_resource(Resource(1, "Pool", ResourceCategory::ToolSlot, 1));
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    AgentId holder_id = mgr->register_agent(std::move(holder));
+    Agent waiter(2, "Waiter");
+    waiter.declare_max_need(1, 1);
+    AgentId waiter_id = mgr->register_agent(std::move(waiter));
+    ASSERT_EQ(mgr->request_resources(holder_id, 1, 1, 1s), RequestStatus::Granted);
+
+    auto at_stop = mgr->request_resources_async(waiter_id, 1, 1, 60s);
+    mgr->stop();
+    ASSERT_EQ(at_stop.wait_for(2s), std::future_status::ready);
+    EXPECT_EQ(at_stop.get(), RequestStatus::Cancelled);
+    EXPECT_EQ(mgr->pending_request_count(), 0u);
+
+    // Likewise for requests still queued when the manager is destroyed
+    mgr->start();
+    auto at_destruction = mgr->request_resources_async(waiter_id, 1, 1, 60s);
+    mgr.reset();
+    ASSERT_EQ(at_destruction.wait_for(2s), std::future_status::ready);
+    EXPECT_EQ(at_destruction.get(), RequestStatus::Cancelled);
+}
+
 // ===========================================================================
 // High contention: many agents competing for scarce resources
 // ===========================================================================
@@ -341,3 +448,116 @@ TEST(ConcurrentAgentsTest, HighContention_ScarceResources) {
     ASSERT_TRUE(res.has_value());
     EXPECT_EQ(res->allocated(), 0);
 }
+
+TEST(ConcurrentAgentsTest, GroupCommitAdmission) {
+    constexpr int NUM_AGENTS = 16;
+
+    Config cfg;
+    cfg.thread_safe = true;
+    cfg.admission.group_commit = true;
+    cfg.admission.window = 200us;
+    cfg.admission.max_batch = 4;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slots", ResourceCategory::ToolSlot, 8));
+
+    std::vector<AgentId> agent_ids;
+    for (int i = 0; i < NUM_AGENTS; ++i) {
+        Agent a(static_cast<AgentId>(i + 1), "Agent-" + std::to_string(i + 1));
+        a.declare_max_need(1, 2);
+        agent_ids.push_back(mgr.register_agent(std::move(a)));
+    }
+
+    // Burst: batches are evaluated greedily against each other's grants. With
+    // claims of 2, the eighth unit would leave every holder short.
+    std::atomic<int> grants{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_AGENTS; ++i) {
+        threads.emplace_back([&, i] {
+            if (mgr.request_resources(agent_ids[i], 1, 1, 0ms) == RequestStatus::Granted) {
+                grants.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    threads.clear();
+    EXPECT_EQ(grants.load(), 7);
+    EXPECT_EQ(mgr.get_resource(1)->available(), 1);
+    EXPECT_TRUE(mgr.is_safe());
+    for (AgentId id : agent_ids) mgr.release_all_resources(id);
+
+    // Request/release cycles through the combiner
+    std::atomic<int> errors{0};
+    for (int i = 0; i < NUM_AGENTS; ++i) {
+        threads.emplace_back([&, i] {
+            for (int op = 0; op < 50; ++op) {
+                if (mgr.request_resources(agent_ids[i], 1, 1, 100ms) == RequestStatus::Granted) {
+                    if (!mgr.is_safe()) errors.fetch_add(1);
+                    mgr.release_resources(agent_ids[i], 1, 1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(mgr.get_resource(1)->available(), 8);
+}
+
+TEST(ConcurrentAgentsTest, SnapshotsStayConsistentUnderChurn) {
+    constexpr int NUM_AGENTS = 6;
+    constexpr ResourceQuantity CAPACITY = 12;
+
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slots", ResourceCategory::ToolSlot, CAPACITY));
+
+    std::vector<AgentId> agent_ids;
+    for (int i = 0; i < NUM_AGENTS; ++i) {
+        Agent a(static_cast<AgentId>(i + 1), "Agent-" + std::to_string(i + 1));
+        a.declare_max_need(1, 3);
+        agent_ids.push_back(mgr.register_agent(std::move(a)));
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> writers;
+    for (int i = 0; i < NUM_AGENTS; ++i) {
+        writers.emplace_back([&, i] {
+            for (int op = 0; op < 300; ++op) {
+                if (mgr.request_resources(agent_ids[i], 1, 1 + op % 2, 10ms) ==
+                    RequestStatus::Granted) {
+                    mgr.release_all_resources(agent_ids[i], 1);
+                }
+            }
+        });
+    }
+
+    // Each snapshot must be one state: what agents hold is what the
+    // resource is missing
+    int mismatches = 0;
+    int snapshots = 0;
+    std::thread reader([&] {
+        while (!done.load()) {
+            auto snap = mgr.get_snapshot();
+            ResourceQuantity held = 0;
+            for (auto& agent : snap.agents) {
+                auto it = agent.allocation.find(1);
+                if (it != agent.allocation.end()) held += it->second;
+            }
+            if (held + snap.available_resources.at(1) != CAPACITY || !snap.is_safe) {
+                ++mismatches;
+            }
+            auto res = mgr.get_resource(1);
+            if (!res || res->allocated() + res->available() != CAPACITY) ++mismatches;
+            ++snapshots;
+        }
+    });
+
+    for (auto& t : writers) t.join();
+    done.store(true);
+    reader.join();
+
+    EXPECT_GT(snapshots, 0);
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_EQ(mgr.get_resource(1)->available(), CAPACITY);
+    EXPECT_EQ(mgr.agent_count(), static_cast<std::size_t>(NUM_AGENTS));
+}
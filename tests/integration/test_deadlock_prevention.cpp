@@ -2,6 +2,7 @@
 #include <agentguard/agentguard.hpp>
 
 #include <atomic>
+#include <future>
 #include <thread>
 #include <vector>
 
@@ -297,3 +298,271 @@ TEST(DeadlockPreventionTest, IndividualRequestsMaintainSafety) {
     mgr.stop();
     EXPECT_TRUE(mgr.is_safe());
 }
+
+// ===========================================================================
+// Queued (callback) requests are re-examined by the background processor
+// only when something relevant changes
+// ===========================================================================
+
+TEST(DeadlockPreventionTest, QueuedRequestGrantedOnceWhenItsResourceIsReleased) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 2));
+    mgr.register_resource(Resource(2, "R2", ResourceCategory::ToolSlot, 4));
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 2);
+    Agent churn(2, "Churn");
+    churn.declare_max_need(2, 4);
+    Agent waiter(3, "Waiter");
+    waiter.declare_max_need(1, 1);
+    AgentId h = mgr.register_agent(std::move(holder));
+    AgentId c = mgr.register_agent(std::move(churn));
+    AgentId w = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(h, 1, 2, 1s), RequestStatus::Granted);
+    mgr.start();
+
+    std::atomic<int> granted{0};
+    std::atomic<int> other{0};
+    mgr.request_resources_callback(w, 1, 1, [&](RequestId, RequestStatus s) {
+        (s == RequestStatus::Granted ? granted : other).fetch_add(1);
+    });
+
+    // Releases of an unrelated resource do not grant it
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(mgr.request_resources(c, 2, 2, 1s), RequestStatus::Granted);
+        mgr.release_resources(c, 2, 2);
+    }
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(granted.load(), 0);
+    EXPECT_EQ(mgr.pending_request_count(), 1u);
+
+    mgr.release_resources(h, 1, 1);
+    for (int i = 0; i < 200 && granted.load() == 0; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    mgr.stop();
+
+    EXPECT_EQ(granted.load(), 1);
+    EXPECT_EQ(other.load(), 0);
+    EXPECT_EQ(mgr.pending_request_count(), 0u);
+}
+
+TEST(DeadlockPreventionTest, UnsafeQueuedRequestWokenByReleaseOfAnotherResource) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 2));
+    mgr.register_resource(Resource(2, "R2", ResourceCategory::ToolSlot, 2));
+
+    // X holds all of R2 and still needs one R1; Z holds one R1 and needs
+    // one R2; Y may take up to two R1.
+    Agent x(1, "X");
+    x.declare_max_need(1, 1);
+    x.declare_max_need(2, 2);
+    Agent z(2, "Z");
+    z.declare_max_need(1, 1);
+    z.declare_max_need(2, 1);
+    Agent y(3, "Y");
+    y.declare_max_need(1, 2);
+    AgentId xid = mgr.register_agent(std::move(x));
+    AgentId zid = mgr.register_agent(std::move(z));
+    AgentId yid = mgr.register_agent(std::move(y));
+    ASSERT_EQ(mgr.request_resources(xid, 2, 2, 1s), RequestStatus::Granted);
+    ASSERT_EQ(mgr.request_resources(zid, 1, 1, 1s), RequestStatus::Granted);
+    mgr.start();
+
+    // Granting Y the last R1 now would leave X and Z waiting on each other
+    std::atomic<int> granted{0};
+    mgr.request_resources_callback(yid, 1, 1, [&](RequestId, RequestStatus s) {
+        if (s == RequestStatus::Granted) granted.fetch_add(1);
+    });
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(granted.load(), 0);
+
+    // Once X gives back one R2, Z can finish first, so the grant is safe
+    mgr.release_resources(xid, 2, 1);
+    for (int i = 0; i < 200 && granted.load() == 0; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    mgr.stop();
+
+    EXPECT_EQ(granted.load(), 1);
+    EXPECT_TRUE(mgr.is_safe());
+}
+
+TEST(DeadlockPreventionTest, QueuedBatchGrantedAllOrNothing) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Quota", ResourceCategory::ApiRateLimit, 1));
+    mgr.register_resource(Resource(2, "Tokens", ResourceCategory::TokenBudget, 100));
+    mgr.register_resource(Resource(3, "Tool", ResourceCategory::ToolSlot, 1));
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    holder.declare_max_need(3, 1);
+    Agent worker(2, "Worker");
+    worker.declare_max_need(1, 1);
+    worker.declare_max_need(2, 50);
+    worker.declare_max_need(3, 1);
+    AgentId h = mgr.register_agent(std::move(holder));
+    AgentId w = mgr.register_agent(std::move(worker));
+    ASSERT_EQ(mgr.request_resources(h, 3, 1, 1s), RequestStatus::Granted);
+    mgr.start();
+
+    auto future = mgr.request_resources_batch_async(w, {{1, 1}, {2, 50}, {3, 1}}, 5s);
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(future.wait_for(0ms), std::future_status::timeout);
+    // Nothing is held while the tool slot is busy
+    EXPECT_EQ(mgr.get_resource(1)->available(), 1);
+    EXPECT_EQ(mgr.get_resource(2)->available(), 100);
+
+    mgr.release_resources(h, 3, 1);
+    ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+    EXPECT_EQ(future.get(), RequestStatus::Granted);
+    EXPECT_EQ(mgr.get_resource(1)->available(), 0);
+    EXPECT_EQ(mgr.get_resource(2)->available(), 50);
+    EXPECT_EQ(mgr.get_resource(3)->available(), 0);
+
+    // A queued batch that cannot be satisfied expires as a whole
+    std::atomic<int> timed_out{0};
+    mgr.request_resources_batch_callback(h, {{1, 1}, {3, 1}}, [&](RequestId, RequestStatus s) {
+        if (s == RequestStatus::TimedOut) timed_out.fetch_add(1);
+    }, 20ms);
+    for (int i = 0; i < 200 && timed_out.load() == 0; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    mgr.stop();
+
+    EXPECT_EQ(timed_out.load(), 1);
+    EXPECT_EQ(mgr.pending_request_count(), 0u);
+    EXPECT_TRUE(mgr.is_safe());
+}
+
+TEST(DeadlockPreventionTest, ProcessorReactsToEventsNotPollInterval) {
+    Config cfg;
+    cfg.thread_safe = true;
+    cfg.processor_poll_interval = std::chrono::seconds(10);
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 1));
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    Agent waiter(2, "Waiter");
+    waiter.declare_max_need(1, 1);
+    AgentId h = mgr.register_agent(std::move(holder));
+    AgentId w = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(h, 1, 1, 1s), RequestStatus::Granted);
+    mgr.start();
+
+    std::atomic<int> granted{0};
+    std::atomic<int> timed_out{0};
+    mgr.request_resources_callback(w, 1, 1, [&](RequestId, RequestStatus s) {
+        if (s == RequestStatus::Granted) granted.fetch_add(1);
+    });
+    // Expires on its own deadline, not on the next poll
+    mgr.request_resources_callback(w, 1, 1, [&](RequestId, RequestStatus s) {
+        if (s == RequestStatus::TimedOut) timed_out.fetch_add(1);
+    }, 30ms);
+
+    auto start = Clock::now();
+    while (timed_out.load() == 0 && Clock::now() - start < 2s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(timed_out.load(), 1);
+    EXPECT_LT(Clock::now() - start, 2s);
+
+    mgr.release_resources(h, 1, 1);
+    start = Clock::now();
+    while (granted.load() == 0 && Clock::now() - start < 2s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(granted.load(), 1);
+    EXPECT_LT(Clock::now() - start, 2s);
+    mgr.stop();
+}
+
+TEST(DeadlockPreventionTest, BlockedCallersWokenByReleaseThatFits) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 2));
+    mgr.register_resource(Resource(2, "R2", ResourceCategory::ToolSlot, 1));
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 2);
+    holder.declare_max_need(2, 1);
+    Agent a(2, "A");
+    a.declare_max_need(1, 2);
+    Agent b(3, "B");
+    b.declare_max_need(2, 1);
+    AgentId h = mgr.register_agent(std::move(holder));
+    AgentId ia = mgr.register_agent(std::move(a));
+    AgentId ib = mgr.register_agent(std::move(b));
+    ASSERT_EQ(mgr.request_resources(h, 1, 2, 1s), RequestStatus::Granted);
+    ASSERT_EQ(mgr.request_resources(h, 2, 1, 1s), RequestStatus::Granted);
+
+    std::atomic<bool> a_done{false};
+    std::atomic<bool> b_done{false};
+    RequestStatus a_status = RequestStatus::Pending;
+    RequestStatus b_status = RequestStatus::Pending;
+    std::thread ta([&] { a_status = mgr.request_resources(ia, 1, 2, 5s); a_done = true; });
+    std::thread tb([&] { b_status = mgr.request_resources(ib, 2, 1, 5s); b_done = true; });
+    std::this_thread::sleep_for(50ms);
+
+    // One unit is not enough for A; nothing for B
+    mgr.release_resources(h, 1, 1);
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(a_done.load());
+    EXPECT_FALSE(b_done.load());
+
+    // Nothing polls, so only a targeted wakeup can grant them
+    auto start = Clock::now();
+    mgr.release_resources(h, 1, 1);
+    ta.join();
+    EXPECT_EQ(a_status, RequestStatus::Granted);
+    EXPECT_LT(Clock::now() - start, 2s);
+    EXPECT_FALSE(b_done.load());
+
+    start = Clock::now();
+    mgr.release_resources(h, 2, 1);
+    tb.join();
+    EXPECT_EQ(b_status, RequestStatus::Granted);
+    EXPECT_LT(Clock::now() - start, 2s);
+}
+
+TEST(DeadlockPreventionTest, BlockedCallersSleepUntilSignalled) {
+    constexpr int NUM_WAITERS = 32;
+
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 1));
+    Agent holder(1000, "Holder");
+    holder.declare_max_need(1, 1);
+    AgentId h = mgr.register_agent(std::move(holder));
+    ASSERT_EQ(mgr.request_resources(h, 1, 1, 1s), RequestStatus::Granted);
+
+    std::vector<AgentId> ids;
+    for (int i = 0; i < NUM_WAITERS; ++i) {
+        Agent a(static_cast<AgentId>(i + 1), "Waiter-" + std::to_string(i));
+        a.declare_max_need(1, 1);
+        ids.push_back(mgr.register_agent(std::move(a)));
+    }
+
+    std::atomic<int> timed_out{0};
+    std::vector<std::thread> threads;
+    for (AgentId id : ids) {
+        threads.emplace_back([&, id] {
+            if (mgr.request_resources(id, 1, 1, 300ms) == RequestStatus::TimedOut) ++timed_out;
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(timed_out.load(), NUM_WAITERS);
+
+    // Each caller wakes once, at its deadline; polling every few
+    // milliseconds would have woken them thousands of times
+    EXPECT_LE(mgr.waiter_wakeups(), static_cast<std::uint64_t>(NUM_WAITERS) * 2);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <agentguard/agentguard.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace agentguard;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records quantities in delivery order; can hold the dispatcher at a gate
+class RecordingMonitor : public Monitor {
+public:
+    void on_event(const MonitorEvent& event) override {
+        {
+            std::unique_lock lock(mutex_);
+            gate_cv_.wait(lock, [this] { return open_; });
+            seen_.push_back(event.quantity.value_or(-1));
+        }
+        if (delay_ > Duration::zero()) std::this_thread::sleep_for(delay_);
+    }
+    void on_snapshot(const SystemSnapshot&) override {}
+
+    void close() { std::lock_guard lock(mutex_); open_ = false; }
+    void open() {
+        { std::lock_guard lock(mutex_); open_ = true; }
+        gate_cv_.notify_all();
+    }
+    void set_delay(Duration d) { delay_ = d; }
+
+    std::vector<ResourceQuantity> seen() const {
+        std::lock_guard lock(mutex_);
+        return seen_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable gate_cv_;
+    bool open_{true};
+    Duration delay_{Duration::zero()};
+    std::vector<ResourceQuantity> seen_;
+};
+
+MonitorEvent make_event(ResourceQuantity qty) {
+    MonitorEvent e;
+    e.type = EventType::RequestGranted;
+    e.timestamp = Clock::now();
+    e.quantity = qty;
+    return e;
+}
+
+} // anonymous namespace
+
+TEST(AsyncMonitorTest, DeliversEventsInOrder) {
+    auto inner = std::make_shared<RecordingMonitor>();
+    AsyncMonitor monitor(inner);
+
+    for (ResourceQuantity i = 0; i < 1000; ++i) monitor.on_event(make_event(i));
+    monitor.flush();
+
+    auto seen = inner->seen();
+    ASSERT_EQ(seen.size(), 1000u);
+    for (ResourceQuantity i = 0; i < 1000; ++i) EXPECT_EQ(seen[i], i);
+    EXPECT_EQ(monitor.dropped_events(), 0u);
+}
+
+TEST(AsyncMonitorTest, DropPolicyCountsOverflow) {
+    auto inner = std::make_shared<RecordingMonitor>();
+    AsyncMonitorConfig cfg;
+    cfg.capacity = 4;
+    cfg.overflow = EventOverflowPolicy::Drop;
+    AsyncMonitor monitor(inner, cfg);
+    EXPECT_EQ(monitor.capacity(), 4u);
+
+    inner->close();
+    for (ResourceQuantity i = 0; i < 20; ++i) monitor.on_event(make_event(i));
+    // Four in the ring, at most one more held by the dispatcher
+    EXPECT_GE(monitor.dropped_events(), 15u);
+
+    inner->open();
+    monitor.flush();
+    EXPECT_EQ(inner->seen().size() + monitor.dropped_events(), 20u);
+}
+
+TEST(AsyncMonitorTest, BlockPolicyLosesNothing) {
+    auto inner = std::make_shared<RecordingMonitor>();
+    inner->set_delay(50us);
+    AsyncMonitorConfig cfg;
+    cfg.capacity = 4;
+    cfg.overflow = EventOverflowPolicy::Block;
+    AsyncMonitor monitor(inner, cfg);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < 50; ++i) monitor.on_event(make_event(i));
+        });
+    }
+    for (auto& p : producers) p.join();
+    monitor.flush();
+
+    EXPECT_EQ(inner->seen().size(), 200u);
+    EXPECT_EQ(monitor.dropped_events(), 0u);
+}
+
+TEST(AsyncMonitorTest, BlockedProducerWakesWhenSpaceFrees) {
+    auto inner = std::make_shared<RecordingMonitor>();
+    AsyncMonitorConfig cfg;
+    cfg.capacity = 4;
+    cfg.overflow = EventOverflowPolicy::Block;
+    AsyncMonitor monitor(inner, cfg);
+
+    inner->close();
+    std::atomic<int> emitted{0};
+    std::thread producer([&] {
+        for (ResourceQuantity i = 0; i < 10; ++i) {
+            monitor.on_event(make_event(i));
+            emitted.fetch_add(1);
+        }
+    });
+    // Four in the ring and one held at the gate; the producer sleeps
+    std::this_thread::sleep_for(30ms);
+    EXPECT_LE(emitted.load(), 5);
+
+    inner->open();
+    producer.join();
+    monitor.flush();
+    auto seen = inner->seen();
+    ASSERT_EQ(seen.size(), 10u);
+    for (ResourceQuantity i = 0; i < 10; ++i) EXPECT_EQ(seen[i], i);
+}
+
+TEST(AsyncMonitorTest, FlushReturnsOnceDispatcherDrains) {
+    auto inner = std::make_shared<RecordingMonitor>();
+    AsyncMonitor monitor(inner);
+
+    inner->close();
+    for (ResourceQuantity i = 0; i < 8; ++i) monitor.on_event(make_event(i));
+
+    std::atomic<int> flushed{0};
+    std::vector<std::thread> flushers;
+    for (int i = 0; i < 2; ++i) {
+        flushers.emplace_back([&] {
+            monitor.flush();
+            flushed.fetch_add(1);
+        });
+    }
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(flushed.load(), 0);
+
+    // Both are woken by the delivery that drains the ring
+    inner->open();
+    for (auto& t : flushers) t.join();
+    EXPECT_EQ(flushed.load(), 2);
+    EXPECT_EQ(inner->seen().size(), 8u);
+}
+
+TEST(AsyncMonitorTest, SamplePolicyThinsBacklog) {
+    auto inner = std::make_shared<RecordingMonitor>();
+    AsyncMonitorConfig cfg;
+    cfg.capacity = 16;
+    cfg.overflow = EventOverflowPolicy::Sample;
+    cfg.sample_every = 4;
+    AsyncMonitor monitor(inner, cfg);
+
+    inner->close();
+    for (ResourceQuantity i = 0; i < 40; ++i) monitor.on_event(make_event(i));
+    inner->open();
+    monitor.flush();
+
+    // Everything up to half full, then one in four
+    auto delivered = inner->seen().size();
+    EXPECT_GT(delivered, 8u);
+    EXPECT_LT(delivered, 40u);
+    EXPECT_EQ(delivered + monitor.dropped_events(), 40u);
+}
+
+TEST(AsyncMonitorTest, ManagerWrapsMonitorWhenConfigured) {
+    Config cfg;
+    cfg.thread_safe = true;
+    cfg.async_monitor.enabled = true;
+    ResourceManager mgr(cfg);
+    auto metrics = std::make_shared<MetricsMonitor>();
+    mgr.set_monitor(metrics);
+
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 4));
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 2);
+    AgentId id = mgr.register_agent(std::move(a));
+    ASSERT_EQ(mgr.request_resources(id, 1, 2, 50ms), RequestStatus::Granted);
+
+    mgr.flush_events();
+    EXPECT_EQ(metrics->get_metrics().granted_requests, 1u);
+}
@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+#include <agentguard/agentguard.hpp>
+#include <agentguard/coroutine.hpp>
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace agentguard;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Single-threaded event loop: completions post handles, the test thread
+// resumes them
+class LoopExecutor {
+public:
+    void operator()(std::coroutine_handle<> handle) {
+        // Notify under the lock: the loop may be destroyed as soon as the
+        // last handle is taken
+        std::lock_guard lock(mutex_);
+        ready_.push_back(handle);
+        cv_.notify_one();
+    }
+
+    // Resumes posted coroutines until `done` holds or `timeout` elapses
+    template <typename Pred>
+    bool run_until(Pred done, Duration timeout) {
+        auto deadline = Clock::now() + timeout;
+        while (!done()) {
+            std::unique_lock lock(mutex_);
+            if (!cv_.wait_until(lock, deadline, [this] { return !ready_.empty(); })) return false;
+            auto handle = ready_.front();
+            ready_.pop_front();
+            lock.unlock();
+            handle.resume();
+        }
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> ready_;
+};
+
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// The executor is held by reference so every task posts to the same loop
+struct PostTo {
+    LoopExecutor* loop;
+    void operator()(std::coroutine_handle<> h) const { (*loop)(h); }
+};
+
+Task use_and_release(ResourceManager& mgr, AgentId id, PostTo exec,
+                     std::vector<RequestStatus>& results) {
+    auto status = co_await acquire(mgr, id, 1, 1, 5s, exec);
+    if (status == RequestStatus::Granted) {
+        mgr.release_resources(id, 1, 1);
+    }
+    results.push_back(status);
+}
+
+} // anonymous namespace
+
+TEST(CoroutineTest, ManyTasksShareOneThread) {
+    constexpr int NUM_TASKS = 200;
+
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slot", ResourceCategory::ToolSlot, 2));
+    mgr.start();
+
+    Agent holder(NUM_TASKS + 1, "Holder");
+    holder.declare_max_need(1, 2);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, 2), RequestStatus::Granted);
+
+    std::vector<AgentId> ids;
+    for (int i = 0; i < NUM_TASKS; ++i) {
+        Agent a(static_cast<AgentId>(i + 1), "Agent-" + std::to_string(i));
+        a.declare_max_need(1, 1);
+        ids.push_back(mgr.register_agent(std::move(a)));
+    }
+
+    LoopExecutor loop;
+    std::vector<RequestStatus> results;
+    for (AgentId id : ids) use_and_release(mgr, id, PostTo{&loop}, results);
+
+    // Every task is suspended; none has resumed yet because only this
+    // thread resumes them
+    EXPECT_TRUE(results.empty());
+    EXPECT_EQ(mgr.pending_request_count(), ids.size());
+    mgr.release_all_resources(holder_id, 1);
+
+    ASSERT_TRUE(loop.run_until([&] { return results.size() == ids.size(); }, 10s));
+    for (auto s : results) EXPECT_EQ(s, RequestStatus::Granted);
+    EXPECT_EQ(mgr.get_resource(1)->available(), 2);
+    mgr.stop();
+}
+
+TEST(CoroutineTest, TimeoutResumesWithTimedOut) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slot", ResourceCategory::ToolSlot, 1));
+    mgr.start();
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    Agent waiter(2, "Waiter");
+    waiter.declare_max_need(1, 1);
+    AgentId waiter_id = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, 1), RequestStatus::Granted);
+
+    LoopExecutor loop;
+    std::optional<RequestStatus> result;
+    auto task = [&]() -> Task {
+        result = co_await acquire(mgr, waiter_id, 1, 1, 20ms, PostTo{&loop});
+    };
+    task();
+
+    ASSERT_TRUE(loop.run_until([&] { return result.has_value(); }, 5s));
+    EXPECT_EQ(*result, RequestStatus::TimedOut);
+    mgr.stop();
+}
+
+TEST(CoroutineTest, DefaultResumesOnCallbackExecutor) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slot", ResourceCategory::ToolSlot, 1));
+    mgr.start();
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    Agent a(2, "Agent-2");
+    a.declare_max_need(1, 1);
+    AgentId id = mgr.register_agent(std::move(a));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, 1), RequestStatus::Granted);
+
+    std::promise<std::thread::id> resumed_on;
+    auto task = [&]() -> Task {
+        auto status = co_await acquire(mgr, id, 1, 1);
+        EXPECT_EQ(status, RequestStatus::Granted);
+        resumed_on.set_value(std::this_thread::get_id());
+    };
+    task();
+    mgr.release_all_resources(holder_id, 1);
+
+    auto f = resumed_on.get_future();
+    ASSERT_EQ(f.wait_for(5s), std::future_status::ready);
+    EXPECT_NE(f.get(), std::this_thread::get_id());
+    mgr.stop();
+}
+
+TEST(CoroutineTest, AcquireAllGrantsEveryPartTogether) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Quota", ResourceCategory::ApiRateLimit, 2));
+    mgr.register_resource(Resource(2, "Tool", ResourceCategory::ToolSlot, 1));
+    mgr.start();
+
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 2);
+    a.declare_max_need(2, 1);
+    AgentId id = mgr.register_agent(std::move(a));
+
+    LoopExecutor loop;
+    std::optional<RequestStatus> result;
+    std::unordered_map<ResourceTypeId, ResourceQuantity> parts{{1, 2}, {2, 1}};
+    auto task = [&]() -> Task {
+        result = co_await acquire_all(mgr, id, parts, 1s, PostTo{&loop});
+    };
+    task();
+
+    ASSERT_TRUE(loop.run_until([&] { return result.has_value(); }, 5s));
+    EXPECT_EQ(*result, RequestStatus::Granted);
+    EXPECT_EQ(mgr.get_resource(1)->available(), 0);
+    EXPECT_EQ(mgr.get_resource(2)->available(), 0);
+    mgr.stop();
+}
+
+TEST(CoroutineTest, UncontendedAcquireDoesNotSuspend) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slot", ResourceCategory::ToolSlot, 1));
+
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 1);
+    AgentId id = mgr.register_agent(std::move(a));
+
+    // Granted on the caller's thread, with no processor and no executor
+    LoopExecutor loop;
+    std::optional<RequestStatus> result;
+    auto task = [&]() -> Task {
+        result = co_await acquire(mgr, id, 1, 1, 1s, PostTo{&loop});
+    };
+    task();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, RequestStatus::Granted);
+    EXPECT_EQ(mgr.get_resource(1)->available(), 0);
+    EXPECT_EQ(mgr.pending_request_count(), 0u);
+}
+
+TEST(CoroutineTest, InvalidRequestsRethrowWithoutQueueing) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slot", ResourceCategory::ToolSlot, 4));
+    mgr.start();
+
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 1);
+    AgentId id = mgr.register_agent(std::move(a));
+
+    int caught = 0;
+    std::unordered_map<ResourceTypeId, ResourceQuantity> parts{{1, 1}, {99, 1}};
+    auto over_claim = [&]() -> Task {
+        try {
+            co_await acquire(mgr, id, 1, 2);
+        } catch (const MaxClaimExceededException&) {
+            ++caught;
+        }
+    };
+    auto unknown_part = [&]() -> Task {
+        try {
+            co_await acquire_all(mgr, id, parts);
+        } catch (const ResourceNotFoundException&) {
+            ++caught;
+        }
+    };
+    over_claim();
+    unknown_part();
+    EXPECT_EQ(caught, 2);
+    EXPECT_EQ(mgr.pending_request_count(), 0u);
+    mgr.stop();
+}
+
+TEST(CoroutineTest, WaitsUseDefaultTimeoutAndStopCancels) {
+    Config cfg;
+    cfg.thread_safe = true;
+    cfg.default_request_timeout = 20ms;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "Slot", ResourceCategory::ToolSlot, 1));
+    mgr.start();
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    Agent waiter(2, "Waiter");
+    waiter.declare_max_need(1, 1);
+    AgentId waiter_id = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, 1), RequestStatus::Granted);
+
+    LoopExecutor loop;
+    std::optional<RequestStatus> result;
+    auto task = [&]() -> Task {
+        result = co_await acquire(mgr, waiter_id, 1, 1, std::nullopt, PostTo{&loop});
+    };
+    task();
+    ASSERT_TRUE(loop.run_until([&] { return result.has_value(); }, 5s));
+    EXPECT_EQ(*result, RequestStatus::TimedOut);
+
+    // Nothing would resolve a request parked after stop()
+    mgr.stop();
+    result.reset();
+    task();
+    ASSERT_TRUE(loop.run_until([&] { return result.has_value(); }, 5s));
+    EXPECT_EQ(*result, RequestStatus::Cancelled);
+    EXPECT_EQ(mgr.pending_request_count(), 0u);
+}
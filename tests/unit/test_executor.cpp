@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <agentguard/agentguard.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace agentguard;
+using namespace std::chrono_literals;
+
+namespace {
+
+template <typename Pred>
+bool wait_for(Pred done, Duration timeout = 5s) {
+    auto deadline = Clock::now() + timeout;
+    while (!done()) {
+        if (Clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TEST(ExecutorTest, PoolRunsEveryTaskAndReportsStats) {
+    ThreadPoolExecutor pool(3);
+    EXPECT_EQ(pool.thread_count(), 3u);
+
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 500; ++i) {
+        pool.execute([&] { ran.fetch_add(1); });
+    }
+    ASSERT_TRUE(wait_for([&] { return pool.stats().completed == 500; }));
+
+    auto stats = pool.stats();
+    EXPECT_EQ(ran.load(), 500);
+    EXPECT_EQ(stats.submitted, 500u);
+    EXPECT_EQ(stats.queue_depth, 0u);
+    EXPECT_EQ(stats.queue_wait_us.count, 500u);
+    EXPECT_EQ(stats.run_time_us.count, 500u);
+}
+
+TEST(ExecutorTest, IdleWorkersStealFromABusyOne) {
+    ThreadPoolExecutor pool(2);
+    std::mutex gate;
+    std::unique_lock hold(gate);
+
+    // Both tasks are queued on the first worker's deque by the blocked
+    // task, so the second can only run if the other worker steals it
+    std::atomic<bool> second_ran{false};
+    pool.execute([&] {
+        pool.execute([&] { second_ran.store(true); });
+        std::lock_guard wait(gate);
+    });
+    EXPECT_TRUE(wait_for([&] { return second_ran.load(); }));
+    hold.unlock();
+
+    EXPECT_TRUE(wait_for([&] { return pool.stats().completed == 2; }));
+    EXPECT_GE(pool.stats().stolen, 1u);
+}
+
+TEST(ExecutorTest, DestructorDrainsQueuedTasks) {
+    std::atomic<int> ran{0};
+    {
+        ThreadPoolExecutor pool(1);
+        for (int i = 0; i < 100; ++i) {
+            pool.execute([&] {
+                std::this_thread::sleep_for(10us);
+                ran.fetch_add(1);
+            });
+        }
+    }
+    EXPECT_EQ(ran.load(), 100);
+}
+
+TEST(ExecutorTest, PoolSurvivesThrowingTask) {
+    ThreadPoolExecutor pool(1);
+    std::atomic<bool> after{false};
+    pool.execute([] { throw std::runtime_error("callback failed"); });
+    pool.execute([&] { after.store(true); });
+    EXPECT_TRUE(wait_for([&] { return after.load(); }));
+}
+
+// A callback that re-enters the manager used to deadlock on the queue lock
+// when it ran from cancel/expire; callbacks now run with no lock held
+TEST(ExecutorTest, CallbacksRunOutsideManagerLocks) {
+    Config cfg;
+    cfg.thread_safe = true;
+    cfg.executor.mode = CallbackExecution::Inline;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 1));
+
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 1);
+    Agent waiter(2, "Waiter");
+    waiter.declare_max_need(1, 1);
+    AgentId h = mgr.register_agent(std::move(holder));
+    AgentId w = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(h, 1, 1, 1s), RequestStatus::Granted);
+    mgr.start();
+
+    std::atomic<int> expired{0};
+    std::atomic<int> granted{0};
+    mgr.request_resources_callback(w, 1, 1, [&](RequestId, RequestStatus s) {
+        if (s != RequestStatus::TimedOut) return;
+        expired.fetch_add(1);
+        // Retry from inside the callback
+        mgr.request_resources_callback(w, 1, 1, [&](RequestId, RequestStatus s2) {
+            if (s2 == RequestStatus::Granted) granted.fetch_add(1);
+        });
+        EXPECT_TRUE(mgr.is_safe());
+    }, 20ms);
+
+    ASSERT_TRUE(wait_for([&] { return expired.load() == 1; }));
+    mgr.release_resources(h, 1, 1);
+    ASSERT_TRUE(wait_for([&] { return granted.load() == 1; }));
+    mgr.stop();
+}
+
+TEST(ExecutorTest, ManagerUsesPoolByDefault) {
+    ResourceManager mgr;
+    auto pool = std::dynamic_pointer_cast<ThreadPoolExecutor>(mgr.executor());
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(pool->thread_count(), 2u);
+
+    auto inline_exec = std::make_shared<InlineExecutor>();
+    mgr.set_executor(inline_exec);
+    EXPECT_EQ(mgr.executor(), inline_exec);
+}
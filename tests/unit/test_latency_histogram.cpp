@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <agentguard/agentguard.hpp>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace agentguard;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, BucketsStayWithinRelativePrecision) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> exponent(0, 40);
+    for (int i = 0; i < 10000; ++i) {
+        std::uint64_t v = rng() >> (63 - exponent(rng));
+        std::uint64_t reported =
+            LatencyHistogram::bucket_value(LatencyHistogram::bucket_index(v));
+        double err = std::abs(static_cast<double>(reported) - static_cast<double>(v));
+        EXPECT_LE(err, static_cast<double>(v) / LatencyHistogram::SUB_BUCKETS + 0.5) << v;
+    }
+    // Small values are exact and indexes never run past the table
+    EXPECT_EQ(LatencyHistogram::bucket_value(LatencyHistogram::bucket_index(17)), 17u);
+    EXPECT_EQ(LatencyHistogram::bucket_index(~std::uint64_t{0}),
+              LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformRange) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.percentile(99.0), 0u);
+    for (std::uint64_t v = 1; v <= 10000; ++v) h.record(v);
+
+    EXPECT_EQ(h.count(), 10000u);
+    EXPECT_NEAR(static_cast<double>(h.percentile(50.0)), 5000.0, 5000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(h.percentile(99.0)), 9900.0, 9900.0 / 32);
+    EXPECT_EQ(h.percentile(100.0), 10000u);
+
+    auto s = h.summary(0.5);
+    EXPECT_DOUBLE_EQ(s.mean, 5000.5 * 0.5);
+    EXPECT_DOUBLE_EQ(s.max, 5000.0);
+    EXPECT_LE(s.p90, s.p99);
+    EXPECT_LE(s.p99, s.p999);
+
+    h.reset();
+    EXPECT_EQ(h.count(), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordingLosesNothing) {
+    LatencyHistogram h;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&h, t] {
+            for (std::uint64_t i = 0; i < 5000; ++i) h.record(i * (t + 1));
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(h.count(), 20000u);
+    EXPECT_EQ(h.summary().max, 4999.0 * 4);
+}
+
+TEST(LatencyHistogramTest, MetricsMonitorBreaksDownSynchronousGrants) {
+    Config cfg;
+    cfg.thread_safe = true;
+    ResourceManager mgr(cfg);
+    auto metrics = std::make_shared<MetricsMonitor>();
+    mgr.set_monitor(metrics);
+
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    mgr.register_resource(Resource(2, "R2", ResourceCategory::ToolSlot, 10));
+    Agent hi(1, "High", PRIORITY_HIGH);
+    hi.declare_max_need(1, 4);
+    Agent lo(2, "Low", PRIORITY_LOW);
+    lo.declare_max_need(2, 4);
+    AgentId hi_id = mgr.register_agent(std::move(hi));
+    AgentId lo_id = mgr.register_agent(std::move(lo));
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(mgr.request_resources(hi_id, 1, 1, 50ms), RequestStatus::Granted);
+    }
+    ASSERT_EQ(mgr.request_resources(lo_id, 2, 2, 50ms), RequestStatus::Granted);
+    mgr.release_resources(hi_id, 1, 3);
+
+    auto m = metrics->get_metrics();
+    EXPECT_EQ(m.wait_time_us.count, 4u);
+    EXPECT_EQ(m.safety_check_us.count, 4u);
+    // One hold per admission plus the release
+    EXPECT_EQ(m.lock_hold_us.count, 5u);
+    EXPECT_GT(m.average_wait_time_ms, 0.0);
+
+    EXPECT_EQ(metrics->latency_for_resource(LatencyMetric::Wait, 1).count, 3u);
+    EXPECT_EQ(metrics->latency_for_resource(LatencyMetric::Wait, 2).count, 1u);
+    EXPECT_EQ(metrics->latency_for_resource(LatencyMetric::Wait, 9).count, 0u);
+    EXPECT_EQ(metrics->latency_for_priority(LatencyMetric::Wait, PriorityClass::High).count, 3u);
+    EXPECT_EQ(metrics->latency_for_priority(LatencyMetric::Wait, PriorityClass::Low).count, 1u);
+    EXPECT_EQ(metrics->latency_for_priority(LatencyMetric::LockHold, PriorityClass::High).count, 4u);
+
+    metrics->reset_metrics();
+    EXPECT_EQ(metrics->get_metrics().wait_time_us.count, 0u);
+    EXPECT_EQ(metrics->latency_for_resource(LatencyMetric::Wait, 1).count, 0u);
+}
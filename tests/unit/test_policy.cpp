@@ -210,3 +210,15 @@ TEST(PolicyTest, DeadlinePolicyOrdersByTimeout) {
     EXPECT_EQ(ordered[1].id, 1);  // 100ms deadline
     EXPECT_EQ(ordered[2].id, 3);  // No deadline (infinite)
 }
+
+// ===========================================================================
+// Snapshot usage
+// ===========================================================================
+
+TEST(PolicyTest, OnlyShortestNeedReadsSnapshot) {
+    EXPECT_FALSE(FifoPolicy().uses_snapshot());
+    EXPECT_FALSE(PriorityPolicy().uses_snapshot());
+    EXPECT_FALSE(DeadlinePolicy().uses_snapshot());
+    EXPECT_FALSE(FairnessPolicy().uses_snapshot());
+    EXPECT_TRUE(ShortestNeedPolicy().uses_snapshot());
+}
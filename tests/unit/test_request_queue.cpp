@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <agentguard/agentguard.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <thread>
 #include <unordered_set>
 
@@ -145,6 +147,33 @@ TEST(RequestQueueTest, CancelNonexistentReturnsFalse) {
 // Cancel all for agent
 // ===========================================================================
 
+TEST(RequestQueueTest, CancelFromMiddleKeepsOrder) {
+    RequestQueue q;
+    std::vector<RequestId> normal;
+    for (int i = 0; i < 50; ++i) {
+        normal.push_back(q.enqueue(make_request(1, 1, 1, PRIORITY_NORMAL)));
+    }
+    RequestId high = q.enqueue(make_request(2, 1, 1, PRIORITY_HIGH));
+
+    // Cancel every third normal request
+    std::vector<RequestId> expected{high};
+    for (std::size_t i = 0; i < normal.size(); ++i) {
+        if (i % 3 == 0) {
+            EXPECT_TRUE(q.cancel(normal[i]));
+        } else {
+            expected.push_back(normal[i]);
+        }
+    }
+    EXPECT_FALSE(q.cancel(normal[0]));
+    EXPECT_EQ(q.size(), expected.size());
+
+    std::vector<RequestId> drained;
+    while (auto req = q.dequeue()) {
+        drained.push_back(req->id);
+    }
+    EXPECT_EQ(drained, expected);
+}
+
 TEST(RequestQueueTest, CancelAllForAgent) {
     RequestQueue q;
     q.enqueue(make_request(1, 1, 1, PRIORITY_NORMAL));
@@ -198,6 +227,32 @@ TEST(RequestQueueTest, ExpireTimedOut) {
     EXPECT_EQ(q.size(), 2);
 }
 
+TEST(RequestQueueTest, NextDeadlineTracksEarliestTimeout) {
+    RequestQueue q;
+    EXPECT_FALSE(q.next_deadline().has_value());
+
+    q.enqueue(make_request(1, 1, 1, PRIORITY_NORMAL));  // no timeout
+    RequestId late = q.enqueue(make_request(2, 1, 1, PRIORITY_NORMAL, 10s));
+    RequestId early = q.enqueue(make_request(3, 1, 1, PRIORITY_NORMAL, 1s));
+
+    auto deadline = q.next_deadline();
+    ASSERT_TRUE(deadline.has_value());
+    auto pending = q.get_all_pending();
+    auto early_req = std::find_if(pending.begin(), pending.end(),
+        [&](const ResourceRequest& r) { return r.id == early; });
+    ASSERT_NE(early_req, pending.end());
+    EXPECT_EQ(*deadline, early_req->submitted_at + 1s);
+
+    // Cancelling the earliest moves the deadline to the next one
+    ASSERT_TRUE(q.cancel(early));
+    deadline = q.next_deadline();
+    ASSERT_TRUE(deadline.has_value());
+    EXPECT_EQ(*deadline, q.find(late)->submitted_at + 10s);
+
+    ASSERT_TRUE(q.cancel(late));
+    EXPECT_FALSE(q.next_deadline().has_value());
+}
+
 TEST(RequestQueueTest, NoExpiredWhenNoTimeouts) {
     RequestQueue q;
     q.enqueue(make_request(1, 1, 1, PRIORITY_NORMAL));
@@ -312,3 +367,110 @@ TEST(RequestQueueTest, WaitAndDequeueSucceeds) {
 
     producer.join();
 }
+
+// ===========================================================================
+// Secondary indices
+// ===========================================================================
+
+TEST(RequestQueueTest, ResourceIndexFollowsRemovals) {
+    RequestQueue q;
+    RequestId a = q.enqueue(make_request(1, 7, 1, PRIORITY_NORMAL));
+    RequestId b = q.enqueue(make_request(2, 7, 1, PRIORITY_HIGH));
+    q.enqueue(make_request(1, 8, 1, PRIORITY_NORMAL));
+
+    auto on7 = q.get_pending_for_resource(7);
+    ASSERT_EQ(on7.size(), 2u);
+    EXPECT_EQ(on7[0].id, b);  // queue order within the resource
+    EXPECT_EQ(on7[1].id, a);
+
+    EXPECT_EQ(q.cancel_all_for_agent(1), 2u);
+    on7 = q.get_pending_for_resource(7);
+    ASSERT_EQ(on7.size(), 1u);
+    EXPECT_EQ(on7[0].id, b);
+    EXPECT_TRUE(q.get_pending_for_resource(8).empty());
+}
+
+TEST(RequestQueueTest, BundleIndexedUnderEachPart) {
+    RequestQueue q;
+    auto req = make_request(1, 0, 0, PRIORITY_NORMAL);
+    req.bundle = {{7, 1}, {8, 2}, {7, 3}};
+    RequestId id = q.enqueue(std::move(req));
+
+    // Repeated parts merge; the first part is mirrored in resource_type
+    auto stored = q.find(id);
+    ASSERT_TRUE(stored.has_value());
+    ASSERT_EQ(stored->bundle.size(), 2u);
+    EXPECT_EQ(stored->resource_type, 7u);
+    EXPECT_EQ(stored->quantity, 4);
+
+    ASSERT_EQ(q.get_pending_for_resource(7).size(), 1u);
+    ASSERT_EQ(q.get_pending_for_resource(8).size(), 1u);
+    EXPECT_TRUE(q.cancel(id));
+    EXPECT_TRUE(q.get_pending_for_resource(7).empty());
+    EXPECT_TRUE(q.get_pending_for_resource(8).empty());
+}
+
+TEST(RequestQueueTest, DequeuedBundleLeavesEveryPartIndex) {
+    RequestQueue q;
+    auto req = make_request(1, 0, 0, PRIORITY_NORMAL);
+    req.bundle = {{7, 1}, {8, 2}, {9, 3}};
+    q.enqueue(std::move(req));
+
+    auto popped = q.dequeue();
+    ASSERT_TRUE(popped.has_value());
+    EXPECT_EQ(popped->bundle.size(), 3u);
+    for (ResourceTypeId rt : {7u, 8u, 9u}) {
+        EXPECT_TRUE(q.get_pending_for_resource(rt).empty()) << "resource " << rt;
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(RequestQueueTest, RemoveDoesNotInvokeCallback) {
+    RequestQueue q;
+    int calls = 0;
+    auto req = make_request(1, 1, 1, PRIORITY_NORMAL);
+    req.callback = [&](RequestId, RequestStatus) { ++calls; };
+    RequestId id = q.enqueue(std::move(req));
+
+    ASSERT_TRUE(q.find(id).has_value());
+    EXPECT_TRUE(q.remove(id));
+    EXPECT_FALSE(q.remove(id));
+    EXPECT_FALSE(q.find(id).has_value());
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(RequestQueueTest, StarvationWatchReportsOldestOnce) {
+    RequestQueue q;
+    RequestId id1 = q.enqueue(make_request(1, 1, 1, PRIORITY_NORMAL));
+    std::this_thread::sleep_for(2ms);
+    RequestId id2 = q.enqueue(make_request(2, 1, 1, PRIORITY_NORMAL));
+    auto cutoff = q.find(id2)->submitted_at - 1ns;
+
+    auto starved = q.take_starved(cutoff);
+    ASSERT_EQ(starved.size(), 1u);
+    EXPECT_EQ(starved[0].id, id1);
+    EXPECT_TRUE(q.take_starved(cutoff).empty());
+    EXPECT_EQ(q.oldest_unreported(), q.find(id2)->submitted_at);
+
+    // Leaving the queue leaves the watch too
+    q.remove(id2);
+    EXPECT_FALSE(q.oldest_unreported().has_value());
+    EXPECT_TRUE(q.take_starved(Clock::now()).empty());
+}
+
+TEST(RequestQueueTest, BoostPriorityMovesRequestForward) {
+    RequestQueue q;
+    RequestId low = q.enqueue(make_request(1, 1, 1, PRIORITY_LOW, 1s));
+    RequestId high = q.enqueue(make_request(2, 1, 1, PRIORITY_HIGH));
+    EXPECT_EQ(q.peek()->id, high);
+
+    EXPECT_EQ(q.boost_priority(low, PRIORITY_CRITICAL), PRIORITY_CRITICAL);
+    EXPECT_EQ(q.peek()->id, low);
+    EXPECT_EQ(q.get_pending_for_resource(1).front().id, low);
+    EXPECT_TRUE(q.next_deadline().has_value());
+
+    EXPECT_EQ(q.boost_priority(high, std::numeric_limits<Priority>::max()),
+              std::numeric_limits<Priority>::max());
+    EXPECT_FALSE(q.boost_priority(999, 1).has_value());
+    EXPECT_EQ(q.size(), 2u);
+}
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 #include <agentguard/agentguard.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <random>
+#include <thread>
+
 using namespace agentguard;
 using namespace std::chrono_literals;
 
@@ -249,6 +256,34 @@ TEST_F(ResourceManagerTest, BatchRequestDeniedIfUnsafe) {
     EXPECT_EQ(status, RequestStatus::Denied);
 }
 
+TEST_F(ResourceManagerTest, ElasticRequestGrantsLargestSafeQuantity) {
+    mgr->register_resource(Resource(1, "Tokens", ResourceCategory::TokenBudget, 10));
+
+    Agent a1(1, "Agent-1");
+    a1.declare_max_need(1, 6);
+    AgentId aid1 = mgr->register_agent(std::move(a1));
+    Agent a2(2, "Agent-2");
+    a2.declare_max_need(1, 10);
+    AgentId aid2 = mgr->register_agent(std::move(a2));
+    ASSERT_EQ(mgr->request_resources(aid1, 1, 5), RequestStatus::Granted);
+
+    // Five are free, but Agent-1 must still be able to take its last one
+    auto grant = mgr->request_resources_elastic(aid2, 1, 2, 10);
+    EXPECT_EQ(grant.status, RequestStatus::Granted);
+    EXPECT_EQ(grant.granted, 4);
+    EXPECT_EQ(mgr->get_resource(1)->available(), 1);
+    EXPECT_TRUE(mgr->is_safe());
+
+    // One left is below the minimum, so the request waits rather than
+    // taking less
+    grant = mgr->request_resources_elastic(aid2, 1, 2, 6, 0ms);
+    EXPECT_EQ(grant.status, RequestStatus::TimedOut);
+    EXPECT_EQ(grant.granted, 0);
+
+    EXPECT_THROW(mgr->request_resources_elastic(aid2, 1, 3, 2), InvalidRequestException);
+    EXPECT_THROW(mgr->request_resources_elastic(aid2, 1, 7, 8), MaxClaimExceededException);
+}
+
 // ===========================================================================
 // is_safe() query
 // ===========================================================================
@@ -323,3 +358,635 @@ TEST_F(ResourceManagerTest, DeregisterReleasesResources) {
     r = mgr->get_resource(1);
     EXPECT_EQ(r->available(), 10);
 }
+
+// ===========================================================================
+// Resident safety state tracks registration order and claim updates
+// ===========================================================================
+
+TEST_F(ResourceManagerTest, NeedsDeclaredBeforeResourceRegistrationAreEnforced) {
+    Agent a1(1, "Agent-1");
+    a1.declare_max_need(1, 8);
+    Agent a2(2, "Agent-2");
+    a2.declare_max_need(1, 8);
+    AgentId id1 = mgr->register_agent(std::move(a1));
+    AgentId id2 = mgr->register_agent(std::move(a2));
+
+    mgr->register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+
+    EXPECT_EQ(mgr->request_resources(id1, 1, 4, 50ms), RequestStatus::Granted);
+    // avail=2, needs {4, 4} -> unsafe, and no processor is running
+    EXPECT_EQ(mgr->request_resources(id2, 1, 4, 50ms), RequestStatus::Denied);
+    EXPECT_TRUE(mgr->is_safe());
+}
+
+TEST_F(ResourceManagerTest, RaisedMaxClaimIsSeenBySafetyCheck) {
+    mgr->register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+
+    Agent a1(1, "Agent-1");
+    a1.declare_max_need(1, 9);
+    Agent a2(2, "Agent-2");
+    a2.declare_max_need(1, 2);
+    AgentId id1 = mgr->register_agent(std::move(a1));
+    AgentId id2 = mgr->register_agent(std::move(a2));
+
+    EXPECT_EQ(mgr->request_resources(id2, 1, 2, 50ms), RequestStatus::Granted);
+    ASSERT_TRUE(mgr->update_agent_max_claim(id2, 1, 8));
+
+    // A1 +3 -> avail=5, needs {A1: 6, A2: 6} -> unsafe
+    EXPECT_EQ(mgr->request_resources(id1, 1, 3, 50ms), RequestStatus::Denied);
+    // A1 +2 -> avail=6, A2 (6) finishes first -> safe
+    EXPECT_EQ(mgr->request_resources(id1, 1, 2, 50ms), RequestStatus::Granted);
+}
+
+TEST(ResourceManagerConfigTest, WorklistSafetyAlgorithmIsUsed) {
+    Config cfg;
+    cfg.thread_safe = false;
+    cfg.safety_algorithm = SafetyAlgorithm::Worklist;
+    ResourceManager mgr(cfg);
+
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    Agent a1(1, "Agent-1");
+    a1.declare_max_need(1, 8);
+    Agent a2(2, "Agent-2");
+    a2.declare_max_need(1, 8);
+    AgentId id1 = mgr.register_agent(std::move(a1));
+    AgentId id2 = mgr.register_agent(std::move(a2));
+
+    EXPECT_EQ(mgr.request_resources(id1, 1, 4, 50ms), RequestStatus::Granted);
+    EXPECT_EQ(mgr.request_resources(id2, 1, 2, 50ms), RequestStatus::Granted);
+    // avail=3, needs {4, 6} -> unsafe
+    EXPECT_EQ(mgr.request_resources(id2, 1, 1, 50ms), RequestStatus::Denied);
+    EXPECT_TRUE(mgr.is_safe());
+}
+
+TEST(ResourceManagerConfigTest, RepeatedGrantsReplayCachedSafeSequence) {
+    Config cfg;
+    cfg.thread_safe = false;
+    cfg.cache_grant_headroom = false;
+    ResourceManager mgr(cfg);
+
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    Agent a1(1, "Agent-1");
+    a1.declare_max_need(1, 4);
+    Agent a2(2, "Agent-2");
+    a2.declare_max_need(1, 4);
+    AgentId id1 = mgr.register_agent(std::move(a1));
+    AgentId id2 = mgr.register_agent(std::move(a2));
+
+    EXPECT_EQ(mgr.request_resources(id1, 1, 1, 50ms), RequestStatus::Granted);
+    EXPECT_EQ(mgr.safety_cache_stats().hits, 0u);
+    EXPECT_EQ(mgr.safety_cache_stats().misses, 1u);
+
+    // The completion order does not change, so every later grant replays it
+    EXPECT_EQ(mgr.request_resources(id1, 1, 1, 50ms), RequestStatus::Granted);
+    EXPECT_EQ(mgr.request_resources(id2, 1, 2, 50ms), RequestStatus::Granted);
+    mgr.release_resources(id1, 1, 2);
+    EXPECT_EQ(mgr.request_resources(id2, 1, 2, 50ms), RequestStatus::Granted);
+    EXPECT_EQ(mgr.safety_cache_stats().hits, 3u);
+    EXPECT_EQ(mgr.safety_cache_stats().misses, 1u);
+
+    Config off = cfg;
+    off.reuse_safe_sequence = false;
+    ResourceManager plain(off);
+    plain.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    AgentId id = plain.register_agent(Agent(1, "Agent-1"));
+    EXPECT_EQ(plain.request_resources(id, 1, 1, 50ms), RequestStatus::Granted);
+    EXPECT_EQ(plain.safety_cache_stats().hits, 0u);
+    EXPECT_EQ(plain.safety_cache_stats().misses, 0u);
+}
+
+TEST(ResourceManagerConfigTest, HeadroomTableAgreesWithFullChecks) {
+    Config on;
+    on.thread_safe = false;
+    Config off = on;
+    off.cache_grant_headroom = false;
+    off.reuse_safe_sequence = false;
+    ResourceManager fast(on);
+    ResourceManager full(off);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<ResourceQuantity> claim(1, 8);
+    for (ResourceTypeId rt = 1; rt <= 3; ++rt) {
+        fast.register_resource(Resource(rt, "R", ResourceCategory::ToolSlot, 10));
+        full.register_resource(Resource(rt, "R", ResourceCategory::ToolSlot, 10));
+    }
+    std::vector<AgentId> ids;
+    for (AgentId a = 1; a <= 5; ++a) {
+        Agent agent(a, "Agent");
+        for (ResourceTypeId rt = 1; rt <= 3; ++rt) agent.declare_max_need(rt, claim(rng));
+        ids.push_back(fast.register_agent(agent));
+        full.register_agent(agent);
+    }
+
+    for (int step = 0; step < 500; ++step) {
+        AgentId id = ids[rng() % ids.size()];
+        ResourceTypeId rt = static_cast<ResourceTypeId>(1 + rng() % 3);
+        auto agent = fast.get_agent(id);
+        ResourceQuantity held = agent->current_allocation().count(rt)
+            ? agent->current_allocation().at(rt) : 0;
+        ResourceQuantity room = agent->max_needs().at(rt) - held;
+
+        if (held > 0 && (room == 0 || rng() % 3 == 0)) {
+            ResourceQuantity qty = 1 + static_cast<ResourceQuantity>(rng() % held);
+            fast.release_resources(id, rt, qty);
+            full.release_resources(id, rt, qty);
+        } else if (room > 0) {
+            ResourceQuantity qty = 1 + static_cast<ResourceQuantity>(rng() % room);
+            ASSERT_EQ(fast.request_resources(id, rt, qty, 0ms),
+                      full.request_resources(id, rt, qty, 0ms)) << "step " << step;
+        }
+    }
+    EXPECT_GT(fast.safety_cache_stats().headroom_hits, 0u);
+    EXPECT_EQ(full.safety_cache_stats().headroom_hits, 0u);
+}
+
+TEST(ResourceManagerConfigTest, UnsafeRequestCostsOneCheckUntilARelease) {
+    Config cfg;
+    cfg.thread_safe = false;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    Agent a(1, "A");
+    a.declare_max_need(1, 6);
+    Agent b(2, "B");
+    b.declare_max_need(1, 10);
+    AgentId a_id = mgr.register_agent(std::move(a));
+    AgentId b_id = mgr.register_agent(std::move(b));
+    ASSERT_EQ(mgr.request_resources(a_id, 1, 4), RequestStatus::Granted);
+    ASSERT_EQ(mgr.request_resources(b_id, 1, 2), RequestStatus::Granted);
+
+    // Each verified grant counts as a replay hit or miss
+    auto checks = [&] {
+        auto s = mgr.safety_cache_stats();
+        return s.hits + s.misses;
+    };
+    // 3 more for B leaves 1 free, short of what either agent still needs
+    auto before = checks();
+    EXPECT_EQ(mgr.request_resources(b_id, 1, 3, 50ms), RequestStatus::Denied);
+    EXPECT_EQ(checks() - before, 1u);
+
+    // Retrying is answered from the recorded bound
+    before = checks();
+    EXPECT_EQ(mgr.request_resources(b_id, 1, 3, 50ms), RequestStatus::Denied);
+    EXPECT_EQ(mgr.request_resources(b_id, 1, 4, 50ms), RequestStatus::Denied);
+    EXPECT_EQ(checks() - before, 0u);
+
+    // A release voids the bound, and the next attempt is checked once more
+    mgr.release_resources(a_id, 1, 4);
+    before = checks();
+    EXPECT_EQ(mgr.request_resources(b_id, 1, 3, 50ms), RequestStatus::Granted);
+    EXPECT_EQ(checks() - before, 1u);
+}
+
+TEST(ResourceManagerConfigTest, ElasticGrantsAgreeWithAndWithoutHeadroom) {
+    Config on;
+    on.thread_safe = false;
+    Config off = on;
+    off.cache_grant_headroom = false;
+    ResourceManager fast(on);
+    ResourceManager bisect(off);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<ResourceQuantity> claim(2, 9);
+    fast.register_resource(Resource(1, "R", ResourceCategory::TokenBudget, 12));
+    bisect.register_resource(Resource(1, "R", ResourceCategory::TokenBudget, 12));
+    std::vector<AgentId> ids;
+    for (AgentId a = 1; a <= 4; ++a) {
+        Agent agent(a, "Agent");
+        agent.declare_max_need(1, claim(rng));
+        ids.push_back(fast.register_agent(agent));
+        bisect.register_agent(agent);
+    }
+
+    for (int step = 0; step < 300; ++step) {
+        AgentId id = ids[rng() % ids.size()];
+        auto agent = fast.get_agent(id);
+        ResourceQuantity held = agent->current_allocation().count(1)
+            ? agent->current_allocation().at(1) : 0;
+        ResourceQuantity room = agent->max_needs().at(1) - held;
+
+        if (held > 0 && (room == 0 || rng() % 3 == 0)) {
+            fast.release_resources(id, 1, held);
+            bisect.release_resources(id, 1, held);
+        } else if (room > 0) {
+            ResourceQuantity lo = 1 + static_cast<ResourceQuantity>(rng() % room);
+            auto a = fast.request_resources_elastic(id, 1, lo, room + 2, 0ms);
+            auto b = bisect.request_resources_elastic(id, 1, lo, room + 2, 0ms);
+            ASSERT_EQ(a.status, b.status) << "step " << step;
+            ASSERT_EQ(a.granted, b.granted) << "step " << step;
+            if (a.status == RequestStatus::Granted) {
+                EXPECT_GE(a.granted, lo);
+                EXPECT_LE(a.granted, room);
+            }
+        }
+    }
+    EXPECT_TRUE(fast.is_safe());
+}
+
+TEST(ResourceManagerConfigTest, PublishedQueriesFollowEveryMutation) {
+    Config cfg;
+    cfg.thread_safe = false;
+    ResourceManager mgr(cfg);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    Agent a1(1, "Agent-1");
+    a1.declare_max_need(1, 5);
+    Agent a2(2, "Agent-2");
+    a2.declare_max_need(1, 5);
+    AgentId id1 = mgr.register_agent(std::move(a1));
+    AgentId id2 = mgr.register_agent(std::move(a2));
+
+    ASSERT_EQ(mgr.request_resources(id1, 1, 4, 50ms), RequestStatus::Granted);
+    ASSERT_EQ(mgr.request_resources(id2, 1, 4, 50ms), RequestStatus::Granted);
+    EXPECT_TRUE(mgr.is_safe());
+    EXPECT_EQ(mgr.get_resource(1)->available(), 2);
+
+    // Raised claims leave avail=2 against needs {6, 6}
+    ASSERT_TRUE(mgr.update_agent_max_claim(id1, 1, 10));
+    ASSERT_TRUE(mgr.update_agent_max_claim(id2, 1, 10));
+    EXPECT_FALSE(mgr.is_safe());
+    EXPECT_FALSE(mgr.get_snapshot().is_safe);
+    EXPECT_EQ(mgr.get_agent(id1)->max_needs().at(1), 10);
+
+    mgr.release_resources(id2, 1, 4);
+    EXPECT_TRUE(mgr.is_safe());
+    EXPECT_EQ(mgr.get_resource(1)->available(), 6);
+    EXPECT_EQ(mgr.get_agent(id2)->current_allocation().count(1) ?
+              mgr.get_agent(id2)->current_allocation().at(1) : 0, 0);
+    EXPECT_EQ(mgr.get_snapshot().available_resources.at(1), 6);
+
+    ASSERT_TRUE(mgr.deregister_agent(id2));
+    EXPECT_EQ(mgr.agent_count(), 1u);
+    EXPECT_FALSE(mgr.get_agent(id2).has_value());
+}
+
+namespace {
+
+// Records every event it is handed, with a configurable subscription
+class SubscribingMonitor : public Monitor {
+public:
+    SubscribingMonitor(EventMask mask, bool durations)
+        : mask_(mask), durations_(durations) {}
+
+    void on_event(const MonitorEvent& event) override {
+        std::lock_guard lock(mutex_);
+        events.push_back(event);
+    }
+    void on_snapshot(const SystemSnapshot&) override {}
+    EventMask subscribed_events() const override { return mask_; }
+    bool consumes_durations() const override { return durations_; }
+
+    std::vector<MonitorEvent> events;  // read once emitters are quiet
+
+private:
+    std::mutex mutex_;
+    EventMask mask_;
+    bool durations_;
+};
+
+} // anonymous namespace
+
+TEST(ResourceManagerConfigTest, MonitorsReceiveOnlySubscribedEvents) {
+    Config cfg;
+    cfg.thread_safe = false;
+    ResourceManager mgr(cfg);
+    auto checks = std::make_shared<SubscribingMonitor>(
+        event_mask({EventType::SafetyCheckPerformed}), false);
+    auto timed = std::make_shared<SubscribingMonitor>(
+        event_mask({EventType::SafetyCheckPerformed, EventType::RequestGranted}), true);
+    auto composite = std::make_shared<CompositeMonitor>();
+    composite->add_monitor(checks);
+    composite->add_monitor(timed);
+    EXPECT_EQ(composite->subscribed_events(),
+              event_mask({EventType::SafetyCheckPerformed, EventType::RequestGranted}));
+    EXPECT_TRUE(composite->consumes_durations());
+
+    // Alone, a monitor that ignores durations gets untimed checks
+    mgr.set_monitor(checks);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 6);
+    AgentId id = mgr.register_agent(std::move(a));
+    ASSERT_EQ(mgr.request_resources(id, 1, 2, 50ms), RequestStatus::Granted);
+    ASSERT_EQ(checks->events.size(), 1u);
+    EXPECT_EQ(checks->events[0].type, EventType::SafetyCheckPerformed);
+    EXPECT_FALSE(checks->events[0].duration_us.has_value());
+
+    checks->events.clear();
+    mgr.set_monitor(composite);
+    ASSERT_EQ(mgr.request_resources(id, 1, 2, 50ms), RequestStatus::Granted);
+    mgr.release_resources(id, 1, 4);
+    ASSERT_EQ(timed->events.size(), 2u);
+    EXPECT_EQ(timed->events[0].type, EventType::SafetyCheckPerformed);
+    EXPECT_TRUE(timed->events[0].duration_us.has_value());
+    EXPECT_EQ(timed->events[1].type, EventType::RequestGranted);
+    // Composite only forwards what each child subscribed to
+    ASSERT_EQ(checks->events.size(), 1u);
+    EXPECT_EQ(checks->events[0].type, EventType::SafetyCheckPerformed);
+}
+
+TEST(ResourceManagerConfigTest, CompositeChildrenAreFixedOnceInstalled) {
+    Config cfg;
+    cfg.thread_safe = false;
+    ResourceManager mgr(cfg);
+    auto checks = std::make_shared<SubscribingMonitor>(
+        event_mask({EventType::SafetyCheckPerformed}), false);
+    auto releases = std::make_shared<SubscribingMonitor>(
+        event_mask({EventType::ResourcesReleased}), false);
+    auto composite = std::make_shared<CompositeMonitor>();
+    composite->add_monitor(checks);
+    mgr.set_monitor(composite);
+
+    // Its subscriptions were cached on install, so a late child would never
+    // see events outside them
+    EXPECT_TRUE(composite->frozen());
+    EXPECT_THROW(composite->add_monitor(releases), std::logic_error);
+
+    // Installing a rebuilt composite picks the new child up
+    auto rebuilt = std::make_shared<CompositeMonitor>();
+    rebuilt->add_monitor(checks);
+    rebuilt->add_monitor(releases);
+    mgr.set_monitor(rebuilt);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 6);
+    AgentId id = mgr.register_agent(std::move(a));
+    ASSERT_EQ(mgr.request_resources(id, 1, 2, 50ms), RequestStatus::Granted);
+    mgr.release_resources(id, 1, 2);
+    EXPECT_EQ(checks->events.size(), 1u);
+    ASSERT_EQ(releases->events.size(), 1u);
+    EXPECT_EQ(releases->events[0].type, EventType::ResourcesReleased);
+}
+
+namespace {
+
+// On every safety check, probes from another thread whether the manager's
+// state lock is free by making a call that takes it exclusively
+class LockProbingMonitor : public Monitor {
+public:
+    void on_event(const MonitorEvent&) override {
+        auto freed = std::make_shared<std::promise<void>>();
+        auto done = freed->get_future();
+        probes_.emplace_back([this, freed] {
+            manager->deregister_agent(9999);
+            freed->set_value();
+        });
+        ++checks;
+        if (done.wait_for(500ms) != std::future_status::ready) ++blocked;
+    }
+    void on_snapshot(const SystemSnapshot&) override {}
+    EventMask subscribed_events() const override {
+        return event_mask({EventType::SafetyCheckPerformed,
+                           EventType::ProbabilisticSafetyCheck});
+    }
+
+    void join() {
+        for (auto& t : probes_) t.join();
+        probes_.clear();
+    }
+
+    ResourceManager* manager{nullptr};
+    std::atomic<int> checks{0};
+    std::atomic<int> blocked{0};
+
+private:
+    std::vector<std::thread> probes_;  // only the checking thread appends
+};
+
+} // anonymous namespace
+
+TEST(ResourceManagerConfigTest, SafetyChecksReportedOutsideStateLock) {
+    Config cfg;
+    ResourceManager mgr(cfg);
+    auto probe = std::make_shared<LockProbingMonitor>();
+    probe->manager = &mgr;
+    mgr.set_monitor(probe);
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 4));
+    mgr.register_resource(Resource(2, "R2", ResourceCategory::ToolSlot, 4));
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 4);
+    a.declare_max_need(2, 4);
+    AgentId id1 = mgr.register_agent(std::move(a));
+    Agent b(2, "Agent-2");
+    b.declare_max_need(1, 4);
+    AgentId id2 = mgr.register_agent(std::move(b));
+
+    // Immediate batch grant
+    ASSERT_EQ(mgr.request_resources_batch(id1, {{1, 4}, {2, 1}}, 50ms),
+              RequestStatus::Granted);
+
+    // A blocked caller checks again once the release arrives
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(20ms);
+        mgr.release_resources(id1, 1, 4);
+    });
+    EXPECT_EQ(mgr.request_resources(id2, 1, 4, 2s), RequestStatus::Granted);
+    releaser.join();
+
+    // The processor checks queued requests
+    mgr.start();
+    auto queued = mgr.request_resources_async(id1, 1, 2, 2s);
+    mgr.release_resources(id2, 1, 4);
+    EXPECT_EQ(queued.get(), RequestStatus::Granted);
+    mgr.stop();
+
+    probe->join();
+    EXPECT_GE(probe->checks.load(), 3);
+    EXPECT_EQ(probe->blocked.load(), 0);
+}
+
+TEST(ResourceManagerConfigTest, SnapshotsEmittedWhileRunning) {
+    Config cfg;
+    cfg.snapshot_interval = 5ms;
+    ResourceManager mgr(cfg);
+    auto metrics = std::make_shared<MetricsMonitor>();
+    std::atomic<bool> alerted{false};
+    metrics->set_utilization_alert_threshold(0.8, [&](const std::string&) {
+        alerted.store(true);
+    });
+    mgr.set_monitor(metrics);
+
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 10));
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 9);
+    AgentId id = mgr.register_agent(std::move(a));
+    ASSERT_EQ(mgr.request_resources(id, 1, 9, 50ms), RequestStatus::Granted);
+
+    mgr.start();
+    for (int i = 0; i < 400 && !alerted.load(); ++i) std::this_thread::sleep_for(5ms);
+    EXPECT_TRUE(alerted.load());
+    EXPECT_NEAR(metrics->get_metrics().resource_utilization_percent, 90.0, 1e-9);
+
+    // Later snapshots follow state changes
+    mgr.release_resources(id, 1, 9);
+    for (int i = 0; i < 400 && metrics->get_metrics().resource_utilization_percent > 0.0; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_EQ(metrics->get_metrics().resource_utilization_percent, 0.0);
+    mgr.stop();
+}
+
+TEST(ResourceManagerConfigTest, StarvedRequestsReportedAndBoosted) {
+    Config cfg;
+    cfg.starvation_threshold = 20ms;
+    cfg.starvation_priority_boost = PRIORITY_CRITICAL;
+    cfg.processor_poll_interval = 5ms;
+    ResourceManager mgr(cfg);
+    auto starved = std::make_shared<SubscribingMonitor>(
+        event_mask({EventType::RequestStarved}), true);
+    mgr.set_monitor(starved);
+
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 4));
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 4);
+    Agent waiter(2, "Waiter", PRIORITY_LOW);
+    waiter.declare_max_need(1, 2);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    AgentId waiter_id = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, 4, 50ms), RequestStatus::Granted);
+
+    mgr.start();
+    RequestId queued = mgr.request_resources_callback(waiter_id, 1, 2,
+                                                      [](RequestId, RequestStatus) {});
+    // A blocked synchronous caller reports itself; meanwhile the processor
+    // wakes when the queued request crosses the threshold
+    EXPECT_EQ(mgr.request_resources(waiter_id, 1, 1, 80ms), RequestStatus::TimedOut);
+    mgr.stop();
+
+    ASSERT_EQ(starved->events.size(), 2u);
+    bool saw_queued = false;
+    for (auto& e : starved->events) {
+        EXPECT_EQ(e.type, EventType::RequestStarved);
+        EXPECT_GE(*e.duration_us, 20000.0);
+        if (e.request_id == queued) {
+            saw_queued = true;
+            EXPECT_EQ(e.priority, PRIORITY_LOW + PRIORITY_CRITICAL);
+        }
+    }
+    EXPECT_TRUE(saw_queued);
+}
+
+TEST(ResourceManagerConfigTest, StarvationReportMayCallBackIntoManager) {
+    Config cfg;
+    cfg.starvation_threshold = 20ms;
+    cfg.processor_poll_interval = 5ms;
+    ResourceManager mgr(cfg);
+
+    mgr.register_resource(Resource(1, "R1", ResourceCategory::ToolSlot, 2));
+    Agent holder(1, "Holder");
+    holder.declare_max_need(1, 2);
+    Agent waiter(2, "Waiter");
+    waiter.declare_max_need(1, 2);
+    AgentId holder_id = mgr.register_agent(std::move(holder));
+    AgentId waiter_id = mgr.register_agent(std::move(waiter));
+    ASSERT_EQ(mgr.request_resources(holder_id, 1, 2, 50ms), RequestStatus::Granted);
+
+    // Relieve starvation from the monitor: the state lock must not be held
+    class Relief : public Monitor {
+    public:
+        Relief(ResourceManager& mgr, AgentId holder) : mgr_(mgr), holder_(holder) {}
+        void on_event(const MonitorEvent&) override { mgr_.release_all_resources(holder_); }
+        void on_snapshot(const SystemSnapshot&) override {}
+        EventMask subscribed_events() const override {
+            return event_mask({EventType::RequestStarved});
+        }
+    private:
+        ResourceManager& mgr_;
+        AgentId holder_;
+    };
+    mgr.set_monitor(std::make_shared<Relief>(mgr, holder_id));
+
+    EXPECT_EQ(mgr.request_resources(waiter_id, 1, 2, 2s), RequestStatus::Granted);
+}
+
+TEST(ResourceManagerConfigTest, SlidingWindowReturnsConsumedUnits) {
+    ResourceManager mgr;
+    Resource api(1, "API", ResourceCategory::ApiRateLimit, 2);
+    api.set_replenish_interval(50ms);
+    mgr.register_resource(std::move(api));
+    mgr.register_resource(Resource(2, "Tool", ResourceCategory::ToolSlot, 1));
+
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 2);
+    a.declare_max_need(2, 1);
+    AgentId id = mgr.register_agent(std::move(a));
+    ASSERT_EQ(mgr.request_resources(id, 1, 2), RequestStatus::Granted);
+    ASSERT_EQ(mgr.request_resources(id, 2, 1), RequestStatus::Granted);
+
+    // Consumed units leave the agent but stay unavailable
+    mgr.consume_resources(id, 1, 2);
+    auto api_state = mgr.get_resource(1);
+    EXPECT_EQ(api_state->allocated(), 0);
+    EXPECT_EQ(api_state->consumed(), 2);
+    EXPECT_EQ(api_state->available(), 0);
+    EXPECT_TRUE(mgr.is_safe());
+
+    // Without a replenish interval consuming is releasing
+    mgr.consume_resources(id, 2, 1);
+    EXPECT_EQ(mgr.get_resource(2)->available(), 1);
+
+    // A blocked request is woken by the refill one window later
+    mgr.start();
+    auto started = Clock::now();
+    EXPECT_EQ(mgr.request_resources(id, 1, 2, 5s), RequestStatus::Granted);
+    EXPECT_GE(Clock::now() - started, 40ms);
+    EXPECT_EQ(mgr.get_resource(1)->consumed(), 0);
+    mgr.stop();
+}
+
+TEST(ResourceManagerConfigTest, TokenBucketRefillsAtSteadyRate) {
+    ResourceManager mgr;
+    auto refills = std::make_shared<SubscribingMonitor>(
+        event_mask({EventType::ResourcesReplenished}), false);
+    mgr.set_monitor(refills);
+    // 100 tokens per 100ms
+    mgr.register_resource(ai::TokenBudget(1, "Tokens", 100, 100ms).as_resource());
+    Agent a(1, "Agent-1");
+    a.declare_max_need(1, 100);
+    AgentId id = mgr.register_agent(std::move(a));
+    ASSERT_EQ(mgr.request_resources(id, 1, 100), RequestStatus::Granted);
+    mgr.consume_resources(id, 1, 100);
+
+    mgr.start();
+    // Half the bucket is back well before the whole of it
+    EXPECT_EQ(mgr.request_resources(id, 1, 50, 5s), RequestStatus::Granted);
+    EXPECT_LT(mgr.get_resource(1)->consumed(), 100);
+    for (int i = 0; i < 400 && mgr.get_resource(1)->consumed() > 0; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    mgr.stop();
+
+    EXPECT_EQ(mgr.get_resource(1)->consumed(), 0);
+    EXPECT_EQ(mgr.get_resource(1)->available(), 50);
+    // Refilled in increments, one per wheel tick or so, not all at once
+    ASSERT_GT(refills->events.size(), 2u);
+    ResourceQuantity total = 0;
+    for (auto& e : refills->events) total += *e.quantity;
+    EXPECT_EQ(total, 100);
+}
+
+TEST(ResourceManagerConfigTest, ManyLimitersShareOneTimerWheel) {
+    constexpr ResourceTypeId NUM_LIMITERS = 300;
+    ResourceManager mgr;
+    Agent a(1, "Agent-1");
+    for (ResourceTypeId rt = 1; rt <= NUM_LIMITERS; ++rt) {
+        ai::RateLimiter limiter(rt, "API-" + std::to_string(rt), 1,
+                                ai::RateLimiter::WindowType::PerSecond);
+        mgr.register_resource(limiter.as_resource());
+        a.declare_max_need(rt, 1);
+    }
+    AgentId id = mgr.register_agent(std::move(a));
+    for (ResourceTypeId rt = 1; rt <= NUM_LIMITERS; ++rt) {
+        ASSERT_EQ(mgr.request_resources(id, rt, 1), RequestStatus::Granted);
+        mgr.consume_resources(id, rt, 1);
+    }
+    EXPECT_EQ(mgr.get_snapshot().available_resources[NUM_LIMITERS], 0);
+
+    mgr.start();
+    auto all_back = [&] {
+        auto snap = mgr.get_snapshot();
+        return std::all_of(snap.available_resources.begin(), snap.available_resources.end(),
+                           [](const auto& kv) { return kv.second == 1; });
+    };
+    for (int i = 0; i < 600 && !all_back(); ++i) std::this_thread::sleep_for(5ms);
+    EXPECT_TRUE(all_back());
+    mgr.stop();
+}
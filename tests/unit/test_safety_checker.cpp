@@ -2,6 +2,7 @@
 #include <agentguard/agentguard.hpp>
 
 #include <algorithm>
+#include <random>
 #include <unordered_set>
 
 using namespace agentguard;
@@ -476,3 +477,202 @@ TEST_F(SafetyCheckerTest, HypotheticalBatchUnsafe) {
     auto result = checker.check_hypothetical_batch(input, batch);
     EXPECT_FALSE(result.is_safe);
 }
+
+// ===========================================================================
+// Dense SafetyMatrix agrees with the map-based input
+// ===========================================================================
+
+TEST_F(SafetyCheckerTest, DenseMatrixMatchesMapInput) {
+    auto safe = make_single_resource_input(1, 10, 3,
+        {{0, {3, 9}}, {1, {2, 4}}, {2, {2, 7}}});
+    auto unsafe = make_single_resource_input(1, 10, 2,
+        {{0, {4, 9}}, {1, {2, 4}}, {2, {2, 7}}});
+
+    auto dense_safe = checker.check_safety(SafetyMatrix::from_input(safe));
+    EXPECT_TRUE(dense_safe.is_safe);
+    EXPECT_EQ(dense_safe.safe_sequence, checker.check_safety(safe).safe_sequence);
+
+    EXPECT_FALSE(checker.check_safety(SafetyMatrix::from_input(unsafe)).is_safe);
+}
+
+TEST_F(SafetyCheckerTest, DenseHypotheticalDoesNotModifyState) {
+    auto input = make_single_resource_input(1, 10, 2,
+        {{1, {4, 8}}, {2, {4, 8}}});
+    auto state = SafetyMatrix::from_input(input);
+
+    EXPECT_FALSE(checker.check_hypothetical_in_place(state, 1, 1, 2).is_safe);
+    EXPECT_EQ(state.available(state.resource_slot(1)), 2);
+    EXPECT_EQ(state.allocation(state.agent_slot(1), state.resource_slot(1)), 4);
+}
+
+TEST_F(SafetyCheckerTest, InPlaceHypotheticalWithUnknownSlotsLeavesLayoutAlone) {
+    auto input = make_single_resource_input(1, 10, 6, {{1, {4, 8}}});
+    auto state = SafetyMatrix::from_input(input);
+
+    // Unknown agent and unknown resource go through a copy
+    EXPECT_TRUE(checker.check_hypothetical_in_place(state, 99, 1, 1).is_safe);
+    checker.check_hypothetical_in_place(state, 1, 42, 1);
+    EXPECT_EQ(state.agent_slot(99), SafetyMatrix::npos);
+    EXPECT_EQ(state.resource_slot(42), SafetyMatrix::npos);
+    EXPECT_EQ(state.agent_count(), 1u);
+}
+
+TEST_F(SafetyCheckerTest, InPlaceBatchRestoresStateForRepeatedCells) {
+    auto input = make_single_resource_input(1, 10, 2,
+        {{1, {4, 8}}, {2, {4, 8}}});
+    auto state = SafetyMatrix::from_input(input);
+
+    // The same cell twice: both grants are applied and both undone
+    std::vector<ResourceRequest> batch(2);
+    for (auto& r : batch) {
+        r.agent_id = 1;
+        r.resource_type = 1;
+        r.quantity = 1;
+    }
+    EXPECT_FALSE(checker.check_hypothetical_batch_in_place(state, batch).is_safe);
+    EXPECT_EQ(state.available(state.resource_slot(1)), 2);
+    EXPECT_EQ(state.allocation(state.agent_slot(1), state.resource_slot(1)), 4);
+
+    // A mutable matrix still gets the copying form unless asked otherwise
+    EXPECT_FALSE(checker.check_hypothetical_batch(state, batch).is_safe);
+    EXPECT_EQ(state.available(state.resource_slot(1)), 2);
+}
+
+TEST_F(SafetyCheckerTest, ReusedResultIsOverwritten) {
+    auto input = make_single_resource_input(1, 10, 2,
+        {{1, {4, 8}}, {2, {4, 8}}});
+    auto state = SafetyMatrix::from_input(input);
+    SafetyCheckResult result;
+
+    checker.check_hypothetical_in_place(state, 1, 1, 2, result);
+    EXPECT_FALSE(result.is_safe);
+    EXPECT_TRUE(result.safe_sequence.empty());
+
+    checker.check_hypothetical_in_place(state, 1, 1, 1, result);
+    EXPECT_FALSE(result.is_safe);
+
+    checker.check_safety(state, result);
+    EXPECT_FALSE(result.is_safe);
+    EXPECT_TRUE(result.safe_sequence.empty());
+
+    auto safe = SafetyMatrix::from_input(
+        make_single_resource_input(1, 10, 4, {{1, {4, 8}}, {2, {2, 4}}}));
+    checker.check_safety(safe, result);
+    EXPECT_TRUE(result.is_safe);
+    EXPECT_EQ(result.safe_sequence.size(), 2u);
+    EXPECT_EQ(result.reason, "Safe state found");
+}
+
+// ===========================================================================
+// Worklist algorithm
+// ===========================================================================
+
+TEST_F(SafetyCheckerTest, WorklistAgreesWithClassicOnRandomStates) {
+    SafetyChecker worklist(SafetyAlgorithm::Worklist);
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<ResourceQuantity> qty(0, 6);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        SafetyCheckInput input;
+        for (ResourceTypeId rt = 1; rt <= 3; ++rt) {
+            input.total[rt] = 20;
+            input.available[rt] = qty(rng) / 2;
+        }
+        for (AgentId a = 1; a <= 6; ++a) {
+            for (ResourceTypeId rt = 1; rt <= 3; ++rt) {
+                ResourceQuantity held = qty(rng);
+                input.allocation[a][rt] = held;
+                input.max_need[a][rt] = held + qty(rng);
+            }
+        }
+
+        auto classic = checker.check_safety(input);
+        auto fast = worklist.check_safety(input);
+        ASSERT_EQ(classic.is_safe, fast.is_safe) << "trial " << trial;
+        EXPECT_EQ(classic.reason, fast.reason) << "trial " << trial;
+        if (!fast.is_safe) continue;
+
+        // The worklist sequence must itself be a valid completion order
+        ASSERT_EQ(fast.safe_sequence.size(), 6u);
+        auto work = input.available;
+        for (AgentId a : fast.safe_sequence) {
+            for (ResourceTypeId rt = 1; rt <= 3; ++rt) {
+                ASSERT_LE(input.max_need[a][rt] - input.allocation[a][rt], work[rt]);
+            }
+            for (ResourceTypeId rt = 1; rt <= 3; ++rt) {
+                work[rt] += input.allocation[a][rt];
+            }
+        }
+    }
+}
+
+TEST_F(SafetyCheckerTest, WorklistHypotheticalUnsafe) {
+    SafetyChecker worklist(SafetyAlgorithm::Worklist);
+    auto input = make_single_resource_input(1, 10, 4,
+        {{1, {3, 8}}, {2, {3, 6}}});
+
+    EXPECT_TRUE(worklist.check_hypothetical(input, 2, 1, 1).is_safe);
+    // avail=2, needs {3, 3}
+    EXPECT_FALSE(worklist.check_hypothetical(input, 1, 1, 2).is_safe);
+}
+
+TEST_F(SafetyCheckerTest, ReplayAcceptsOnlyValidCompleteSequences) {
+    // avail=3, needs {A1: 3, A2: 2, A3: 7}
+    auto input = make_single_resource_input(1, 15, 3,
+        {{1, {2, 5}}, {2, {5, 7}}, {3, {5, 12}}});
+    auto state = SafetyMatrix::from_input(input);
+
+    auto result = checker.check_safety(state);
+    ASSERT_TRUE(result.is_safe);
+    EXPECT_TRUE(checker.replay_sequence(state, result.safe_sequence));
+    EXPECT_TRUE(checker.replay_sequence(state, {2, 1, 3}));
+
+    EXPECT_FALSE(checker.replay_sequence(state, {3, 1, 2}));  // A3 cannot go first
+    EXPECT_FALSE(checker.replay_sequence(state, {1, 2}));     // A3 missing
+    EXPECT_FALSE(checker.replay_sequence(state, {1, 2, 9}));  // unknown agent
+
+    // Granting A3 one unit leaves avail=2: {2, 1, 3} still works, {1, 2, 3}
+    // no longer does
+    EXPECT_TRUE(checker.replay_hypothetical(state, 3, 1, 1, {2, 1, 3}));
+    EXPECT_FALSE(checker.replay_hypothetical(state, 3, 1, 1, {1, 2, 3}));
+    EXPECT_EQ(state.available(state.resource_slot(1)), 3);
+}
+
+// ===========================================================================
+// Row kernels
+// ===========================================================================
+
+TEST_F(SafetyCheckerTest, SimdKernelsMatchScalar) {
+    SafetyChecker scalar(SafetyAlgorithm::Classic, false);
+    EXPECT_STREQ(scalar.kernel_name(), "scalar");
+
+    std::mt19937 rng(777);
+    std::uniform_int_distribution<ResourceQuantity> qty(0, 4);
+
+    // 37 resource types: several full vector blocks plus zero padding
+    int safe_count = 0;
+    for (int trial = 0; trial < 100; ++trial) {
+        SafetyCheckInput input;
+        for (ResourceTypeId rt = 1; rt <= 37; ++rt) {
+            input.total[rt] = 40;
+            input.available[rt] = qty(rng) / 2;
+        }
+        for (AgentId a = 1; a <= 8; ++a) {
+            for (ResourceTypeId rt = 1; rt <= 37; ++rt) {
+                ResourceQuantity held = qty(rng);
+                input.allocation[a][rt] = held;
+                // Sparse extra needs keep the mix of safe and unsafe states
+                input.max_need[a][rt] = held + (rt == a * 4 ? qty(rng) + 1 : 0);
+            }
+        }
+
+        auto expected = scalar.check_safety(input);
+        auto actual = checker.check_safety(input);
+        ASSERT_EQ(expected.is_safe, actual.is_safe) << checker.kernel_name();
+        safe_count += actual.is_safe ? 1 : 0;
+        EXPECT_EQ(expected.safe_sequence, actual.safe_sequence);
+        EXPECT_EQ(expected.reason, actual.reason);
+    }
+    EXPECT_GT(safe_count, 0);
+    EXPECT_LT(safe_count, 100);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <agentguard/agentguard.hpp>
+
+using namespace agentguard;
+
+// ===========================================================================
+// Slot assignment and stability
+// ===========================================================================
+
+TEST(SafetyMatrixTest, SlotsAreStableAcrossRemoval) {
+    SafetyMatrix m;
+    std::size_t r1 = m.add_resource(10);
+    std::size_t r2 = m.add_resource(20);
+    std::size_t a1 = m.add_agent(1);
+    std::size_t a2 = m.add_agent(2);
+    std::size_t a3 = m.add_agent(3);
+
+    EXPECT_NE(r1, r2);
+    EXPECT_EQ(m.agent_count(), 3);
+    EXPECT_EQ(m.resource_count(), 2);
+
+    ASSERT_TRUE(m.remove_agent(2));
+    EXPECT_EQ(m.agent_slot(1), a1);
+    EXPECT_EQ(m.agent_slot(3), a3);
+    EXPECT_EQ(m.agent_slot(2), SafetyMatrix::npos);
+    EXPECT_FALSE(m.row_active(a2));
+
+    // Freed row is reused rather than growing the matrix
+    std::size_t a4 = m.add_agent(4);
+    EXPECT_EQ(a4, a2);
+    EXPECT_EQ(m.row_count(), 3);
+}
+
+TEST(SafetyMatrixTest, AddExistingReturnsSameSlot) {
+    SafetyMatrix m;
+    std::size_t a = m.add_agent(7);
+    std::size_t r = m.add_resource(3);
+    EXPECT_EQ(m.add_agent(7), a);
+    EXPECT_EQ(m.add_resource(3), r);
+    EXPECT_EQ(m.agent_count(), 1);
+    EXPECT_EQ(m.resource_count(), 1);
+}
+
+TEST(SafetyMatrixTest, ColumnGrowthPreservesCells) {
+    SafetyMatrix m;
+    std::size_t row = m.add_agent(1);
+    std::size_t first = m.add_resource(0);
+    m.set_max_need(row, first, 9);
+    m.set_allocation(row, first, 4);
+
+    // Force several column growths
+    for (ResourceTypeId rt = 1; rt < 40; ++rt) {
+        std::size_t col = m.add_resource(rt);
+        m.set_max_need(row, col, static_cast<ResourceQuantity>(rt));
+    }
+
+    EXPECT_GE(m.stride(), 40u);
+    EXPECT_EQ(m.max_need(row, first), 9);
+    EXPECT_EQ(m.allocation(row, first), 4);
+    EXPECT_EQ(m.need(row, first), 5);
+    EXPECT_EQ(m.max_need(row, m.resource_slot(39)), 39);
+}
+
+// ===========================================================================
+// Cell bookkeeping
+// ===========================================================================
+
+TEST(SafetyMatrixTest, AllocateKeepsNeedAndAvailableConsistent) {
+    SafetyMatrix m;
+    std::size_t col = m.add_resource(1);
+    std::size_t row = m.add_agent(1);
+    m.set_total(col, 10);
+    m.set_available(col, 10);
+    m.set_max_need(row, col, 6);
+
+    m.allocate(row, col, 4);
+    EXPECT_EQ(m.allocation(row, col), 4);
+    EXPECT_EQ(m.need(row, col), 2);
+    EXPECT_EQ(m.available(col), 6);
+
+    m.allocate(row, col, -4);
+    EXPECT_EQ(m.allocation(row, col), 0);
+    EXPECT_EQ(m.need(row, col), 6);
+    EXPECT_EQ(m.available(col), 10);
+}
+
+TEST(SafetyMatrixTest, RemovedResourceColumnIsZeroed) {
+    SafetyMatrix m;
+    std::size_t col = m.add_resource(1);
+    std::size_t row = m.add_agent(1);
+    m.set_total(col, 5);
+    m.set_available(col, 5);
+    m.set_max_need(row, col, 3);
+
+    ASSERT_TRUE(m.remove_resource(1));
+    EXPECT_EQ(m.need(row, col), 0);
+    EXPECT_EQ(m.total(col), 0);
+    EXPECT_FALSE(m.column_active(col));
+}
+
+// ===========================================================================
+// Map adapter round trip
+// ===========================================================================
+
+TEST(SafetyMatrixTest, RoundTripThroughInput) {
+    SafetyCheckInput input;
+    input.total[1] = 10;
+    input.total[2] = 4;
+    input.available[1] = 3;
+    input.available[2] = 1;
+    input.allocation[1][1] = 5;
+    input.allocation[2][2] = 3;
+    input.max_need[1][1] = 7;
+    input.max_need[2][2] = 4;
+
+    auto m = SafetyMatrix::from_input(input);
+    EXPECT_EQ(m.agent_count(), 2);
+    EXPECT_EQ(m.resource_count(), 2);
+    EXPECT_EQ(m.need(m.agent_slot(1), m.resource_slot(1)), 2);
+
+    auto back = m.to_input();
+    EXPECT_EQ(back.total, input.total);
+    EXPECT_EQ(back.available, input.available);
+    EXPECT_EQ(back.allocation, input.allocation);
+    EXPECT_EQ(back.max_need, input.max_need);
+}
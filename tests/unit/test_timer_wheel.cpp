@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <agentguard/agentguard.hpp>
+
+#include <algorithm>
+
+using namespace agentguard;
+using namespace std::chrono_literals;
+
+namespace {
+
+const Timestamp T0 = Timestamp(1h);
+
+} // anonymous namespace
+
+TEST(TimerWheelTest, FiresAtOrAfterExpiryNeverBefore) {
+    TimerWheel wheel(10ms, 8, T0);
+    wheel.schedule(T0 + 25ms, 1);
+    wheel.schedule(T0 + 40ms, 2);
+    EXPECT_EQ(wheel.size(), 2u);
+    EXPECT_EQ(wheel.next_expiry(), T0 + 30ms);  // rounded up to a tick
+
+    EXPECT_TRUE(wheel.advance(T0 + 29ms).empty());
+    EXPECT_EQ(wheel.advance(T0 + 30ms), std::vector<std::uint64_t>{1});
+    EXPECT_EQ(wheel.next_expiry(), T0 + 40ms);
+    EXPECT_EQ(wheel.advance(T0 + 45ms), std::vector<std::uint64_t>{2});
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_FALSE(wheel.next_expiry().has_value());
+}
+
+TEST(TimerWheelTest, TimersBeyondOneRevolutionWaitForTheirLap) {
+    // 8 slots of 10ms: a lap is 80ms, so 25ms and 185ms share a bucket
+    TimerWheel wheel(10ms, 8, T0);
+    wheel.schedule(T0 + 185ms, 7);
+    EXPECT_FALSE(wheel.schedule(T0 + 190ms, 8));
+    EXPECT_TRUE(wheel.schedule(T0 + 25ms, 3));
+
+    EXPECT_EQ(wheel.advance(T0 + 30ms), std::vector<std::uint64_t>{3});
+    // Nothing in this lap: look again when it ends
+    EXPECT_EQ(wheel.next_expiry(), T0 + 120ms);
+    EXPECT_TRUE(wheel.advance(T0 + 120ms).empty());
+    EXPECT_EQ(wheel.next_expiry(), T0 + 190ms);
+
+    // A long gap fires everything overdue in one pass
+    auto fired = wheel.advance(T0 + 1s);
+    std::sort(fired.begin(), fired.end());
+    EXPECT_EQ(fired, (std::vector<std::uint64_t>{7, 8}));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, PastExpiryFiresOnNextAdvance) {
+    TimerWheel wheel(10ms, 4, T0);
+    wheel.advance(T0 + 50ms);
+    EXPECT_TRUE(wheel.schedule(T0 + 5ms, 1));
+    EXPECT_EQ(wheel.advance(T0 + 60ms), std::vector<std::uint64_t>{1});
+}